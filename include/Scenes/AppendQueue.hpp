@@ -0,0 +1,136 @@
+/**
+ * @file AppendQueue.hpp
+ * @brief Contains the AppendQueue class along with relevant types and functions.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Scenes
+{
+    /**
+     * @brief A lock-free queue that many threads push to and a single thread drains.
+     *
+     * Pushing is a single compare-and-swap onto a linked stack, so producers never block each other or the consumer.
+     * The consumer takes the whole stack with one exchange and hands its values over in the order they were pushed.
+     *
+     * @tparam T The type of value queued.
+     */
+    template<class T>
+    class AppendQueue
+    {
+    public:
+        AppendQueue(const AppendQueue&) = delete;
+        AppendQueue& operator=(const AppendQueue&) = delete;
+
+        AppendQueue() noexcept;
+
+        /**
+         * @brief Takes over the values queued in another AppendQueue.
+         *
+         * @warning Not thread-safe. Nothing may push to other while it is moved.
+         */
+        AppendQueue(
+            AppendQueue&& other
+        ) noexcept;
+
+        ~AppendQueue();
+
+        /**
+         * @brief Queues a value. Safe to call from any number of threads at once.
+         *
+         * @param value The value to queue.
+         */
+        void push(
+            T value
+        );
+
+        /**
+         * @brief Removes every queued value, oldest first. Must only be called by one thread at a time.
+         *
+         * @param consume Called with every removed value.
+         * @return The number of values removed.
+         */
+        template<class Consume>
+        size_t drain(
+            Consume&& consume
+        );
+
+        /**
+         * @brief Checks if nothing is queued. May be outdated as soon as it returns if other threads are pushing.
+         */
+        [[nodiscard]] bool empty() const noexcept;
+
+    private:
+        /**
+         * @internal A queued value and the value queued before it.
+         */
+        struct Node
+        {
+            T value; //!< @internal The queued value.
+            Node* next; //!< @internal The node pushed before this one.
+        };
+
+        std::atomic<Node*> _head; //!< @internal The node pushed last.
+    };
+
+    template<class T>
+    AppendQueue<T>::AppendQueue() noexcept
+        : _head(nullptr)
+    {}
+
+    template<class T>
+    AppendQueue<T>::AppendQueue(AppendQueue&& other) noexcept
+        : _head(other._head.exchange(nullptr, std::memory_order_acquire))
+    {}
+
+    template<class T>
+    AppendQueue<T>::~AppendQueue()
+    {
+        drain([](T&&) {});
+    }
+
+    template<class T>
+    void AppendQueue<T>::push(T value)
+    {
+        auto node = new Node{ std::move(value), _head.load(std::memory_order_relaxed) };
+        while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    template<class T>
+    template<class Consume>
+    size_t AppendQueue<T>::drain(Consume&& consume)
+    {
+        // Taking the whole stack at once means no other thread can see a node being removed, which avoids ABA.
+        Node* node = _head.exchange(nullptr, std::memory_order_acquire);
+
+        Node* oldest = nullptr;
+        while (node)
+            oldest = std::exchange(node, std::exchange(node->next, oldest));
+
+        size_t drained = 0;
+        try
+        {
+            for (; oldest; drained++)
+            {
+                consume(std::move(oldest->value));
+                delete std::exchange(oldest, oldest->next);
+            }
+        } catch (...)
+        {
+            while (oldest)
+                delete std::exchange(oldest, oldest->next);
+            throw;
+        }
+
+        return drained;
+    }
+
+    template<class T>
+    bool AppendQueue<T>::empty() const noexcept
+    {
+        return _head.load(std::memory_order_relaxed) == nullptr;
+    }
+} // Scenes
@@ -4,12 +4,14 @@
  */
 
 #pragma once
-#include <functional>
+#include <atomic>
+#include <concepts>
 #include <stdexcept>
 #include <string>
 #include <typeinfo>
 #include <utility>
 
+#include "EventFunction.hpp"
 #include "EventLog.hpp"
 
 namespace Scenes
@@ -18,6 +20,9 @@ namespace Scenes
      * @brief Creates an eventString for comparison or querying purposes.
      * @relates Event
      *
+     * @remark Events are logged under an EventKey, so this is only needed to talk to the string interface of an
+     * EventLog.
+     *
      * @param eventName The name of the Event.
      * @param returnValue the return value of the Event.
      * @return a created eventString.
@@ -27,6 +32,15 @@ namespace Scenes
         int returnValue
     ) noexcept;
 
+    /**
+     * @brief Decides whether an Event logs its own calls.
+     */
+    enum class EventLogging
+    {
+        OnCall, //!< Every call is logged as soon as it returns.
+        Deferred //!< Calls aren't logged by the Event, as their results are logged later by whoever started them.
+    };
+
     /**
      * @brief Runs a stored function and logs its results to a given eventLog.
      *
@@ -34,8 +48,14 @@ namespace Scenes
      * returning an integer. Calling an event through the () operator both calls the internal functor and logs the event
      * call to a provided eventLog.
      *
-     * Events are logged via an eventString, which provides the log the event name and its return value in a
-     * string format.
+     * The functor is held in an EventFunction, so small functors are stored inside the Event and calling one never
+     * allocates. Events are move-only; look them up by reference rather than copying them.
+     *
+     * Events are logged via an EventKey, which provides the log the event's interned name and its return value. The
+     * name is interned once when the Event is created.
+     *
+     * An Event may be called from other threads if its eventLog is concurrent. Each call logs its own return value,
+     * and @c eventString() and @c eventKey() report the return value of whichever call finished last.
      *
      * @tparam Args The arguments taken in by the stored functor.
      */
@@ -52,20 +72,35 @@ namespace Scenes
          * @param func The stored functor.
          * @param name The name of the event.
          * @param eventLogRef A reference to the eventLog that this instance will log to.
+         * @param logging Whether calls are logged by this Event.
          */
+		template<class Function> requires std::is_invocable_r_v<int, std::decay_t<Function>&, Args...>
 		Event(
-			std::function<int(Args ...)> func,
+			Function&& func,
 			const std::string& name,
-			EventLog& eventLogRef
+			EventLog& eventLogRef,
+			EventLogging logging = EventLogging::OnCall
+		);
+
+        /**
+         * @brief Run the stored functor and logs its result to eventLogRef, unless its logging is deferred.
+         *
+         * @param args The arguments _function.
+         * @return The return value of _function.
+         */
+		int operator()(
+			Args ... args
 		);
 
         /**
-         * @brief Run the stored functor and logs its result to eventLogRef.
+         * @brief Runs the stored functor and collects its result into a batch, unless its logging is deferred.
          *
+         * @param batch The batch that adds the result to eventLogRef when it is committed.
          * @param args The arguments _function.
          * @return The return value of _function.
          */
 		int operator()(
+			EventBatch& batch,
 			Args ... args
 		);
 
@@ -76,6 +111,13 @@ namespace Scenes
          */
 		[[nodiscard]] std::string eventString() const noexcept;
 
+        /**
+         * @brief Determine the EventKey of this Event.
+         *
+         * @return The key this Event's latest call was logged under.
+         */
+		[[nodiscard]] EventKey eventKey() const noexcept;
+
         /**
           * @brief Determine the type of the target of this Event.
           *
@@ -95,18 +137,20 @@ namespace Scenes
         bool operator!=(const Event& rhs) const;
 
     protected:
-		const std::function<int(Args ...)> _function; //!< The stored functor.
-		const std::string _name; //!< This Event's name.
-		int _returnValue; //!< The return value of _function. Populated only after _function is called.
+		EventFunction<int(Args ...)> _function; //!< The stored functor.
+		std::string _name; //!< This Event's name.
+		EventId _id; //!< This Event's name as interned by _eventLogRef.
+		alignas(std::atomic_ref<int>::required_alignment) int _returnValue; //!< The latest return value of _function.
 		EventLog& _eventLogRef; //!< A reference to the eventLog this Event will log to.
+		EventLogging _logging; //!< Whether calls are logged by this Event.
 	};
 
 
 	template<class ...Args>
-	Event<Args...>::Event(std::function<int(Args ...)> func,
-                          const std::string& name,EventLog& eventLogRef)
-		: _function(std::move(func)), _name(name), _returnValue(int()),
-          _eventLogRef(eventLogRef)
+	template<class Function> requires std::is_invocable_r_v<int, std::decay_t<Function>&, Args...>
+	Event<Args...>::Event(Function&& func, const std::string& name, EventLog& eventLogRef, EventLogging logging)
+		: _function(std::forward<Function>(func)), _name(name), _id(eventLogRef.intern(name)), _returnValue(int()),
+          _eventLogRef(eventLogRef), _logging(logging)
 	{
 		if (name.find(',') != std::string::npos)
 			throw std::invalid_argument{ "Event name cannot contain ','." };
@@ -120,13 +164,19 @@ namespace Scenes
 	template<class ...Args>
 	std::string Event<Args...>::eventString() const noexcept
 	{
-		return name() + "," + std::to_string(_returnValue);
+		return name() + "," + std::to_string(eventKey().returnValue);
+	}
+
+	template<class ...Args>
+	EventKey Event<Args...>::eventKey() const noexcept
+	{
+		return { _id, std::atomic_ref(const_cast<int&>(_returnValue)).load(std::memory_order_relaxed) };
 	}
 
 	template<class ...Args>
 	const std::type_info& Event<Args...>::targetType() const noexcept
 	{
-		return _function.target_type();
+		return _function.targetType();
 	}
 
 	template<class ...Args>
@@ -138,16 +188,29 @@ namespace Scenes
 	template<class ...Args>
 	int Event<Args...>::operator()(Args ...args)
 	{
-		_returnValue = _function(args...);
-		_eventLogRef.addLog(eventString());
-		return _returnValue;
+		const int returnValue = _function(std::forward<Args>(args)...);
+		std::atomic_ref(_returnValue).store(returnValue, std::memory_order_relaxed);
+		if (_logging == EventLogging::OnCall)
+			_eventLogRef.addLog(EventKey{ _id, returnValue });
+		return returnValue;
+	}
+
+	template<class ...Args>
+	int Event<Args...>::operator()(EventBatch& batch, Args ...args)
+	{
+		const int returnValue = _function(std::forward<Args>(args)...);
+		std::atomic_ref(_returnValue).store(returnValue, std::memory_order_relaxed);
+		if (_logging == EventLogging::OnCall)
+			batch.add(_eventLogRef, EventKey{ _id, returnValue });
+		return returnValue;
 	}
 
     template<class... Args>
     bool Event<Args...>::operator==(const Event& rhs) const
     {
         return _name == rhs._name &&
-               _returnValue == rhs._returnValue;
+               std::atomic_ref(const_cast<int&>(_returnValue)).load(std::memory_order_relaxed)
+               == std::atomic_ref(const_cast<int&>(rhs._returnValue)).load(std::memory_order_relaxed);
     }
 
 #pragma clang diagnostic push
@@ -0,0 +1,206 @@
+/**
+ * @file EventArgument.hpp
+ * @brief Contains the EventArgument class along with relevant types and functions.
+ */
+
+#pragma once
+#include <concepts>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+
+namespace Scenes
+{
+    /**
+     * @brief Thrown when the text of an event argument can't be parsed into the type its Event takes.
+     */
+    class EventArgumentError : public std::invalid_argument
+    {
+    public:
+        using std::invalid_argument::invalid_argument;
+    };
+
+    /**
+     * @brief The argument types stored directly inside an EventArgument.
+     */
+    template<class T>
+    concept BuiltinArgument = std::same_as<T, int> || std::same_as<T, double> || std::same_as<T, std::string>;
+
+    /**
+     * @brief An Event argument, parsed from the text of a Line once rather than every time the Line is read.
+     *
+     * An EventArgument holds an int, a double, a string, or a value of any other type an Event was added with a parser
+     * for. Values of other types are shared between copies, so copying a Line never copies its parsed argument.
+     */
+    class EventArgument
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the EventArgument class holding an empty string.
+         */
+        EventArgument() noexcept;
+
+        EventArgument(
+            std::string text
+        ) noexcept;
+
+        EventArgument(
+            const char* text
+        );
+
+        EventArgument(
+            int value
+        ) noexcept;
+
+        EventArgument(
+            double value
+        ) noexcept;
+
+        /**
+         * @brief Creates an EventArgument holding a value of any type.
+         *
+         * @tparam T The type of the value, which is stored directly if it is a BuiltinArgument.
+         * @param value The value to hold.
+         */
+        template<class T>
+        [[nodiscard]] static EventArgument make(
+            T value
+        );
+
+        /**
+         * @brief Checks if this EventArgument holds a value of a given type.
+         */
+        template<class T>
+        [[nodiscard]] bool holds() const noexcept;
+
+        /**
+         * @brief Gets the value held by this EventArgument.
+         *
+         * @tparam T The type of the held value.
+         * @return The held value.
+         * @throws std::bad_variant_access if this EventArgument doesn't hold a T.
+         */
+        template<class T>
+        [[nodiscard]] const T& get() const;
+
+    private:
+        /**
+         * @internal A value of a type that isn't a BuiltinArgument.
+         */
+        struct Custom
+        {
+            std::shared_ptr<const void> value; //!< @internal The held value.
+            const std::type_info* type; //!< @internal The type of the held value.
+        };
+
+        explicit EventArgument(Custom custom) noexcept;
+
+        std::variant<std::string, int, double, Custom> _value; //!< @internal The held value.
+    };
+
+    using ArgumentParser = std::function<EventArgument(const std::string&)>; //!< Parses the text of an event argument.
+
+    /**
+     * @brief Parses the text of an event argument as a BuiltinArgument.
+     * @relates EventArgument
+     *
+     * Numbers must take up the whole text, so "10" parses as an int but "10 gold" doesn't.
+     *
+     * @param text The text to parse.
+     * @return The parsed value.
+     * @throws EventArgumentError if text isn't a valid T.
+     */
+    template<BuiltinArgument T>
+    [[nodiscard]] T parseArgument(
+        const std::string& text
+    );
+
+    template<>
+    [[nodiscard]] int parseArgument<int>(
+        const std::string& text
+    );
+
+    template<>
+    [[nodiscard]] double parseArgument<double>(
+        const std::string& text
+    );
+
+    template<>
+    [[nodiscard]] std::string parseArgument<std::string>(
+        const std::string& text
+    );
+
+    /**
+     * @internal Finds the single argument type of a functor or function pointer.
+     */
+    template<class Function, class = void>
+    struct ArgumentOf
+    {};
+
+    template<class R, class A>
+    struct ArgumentOf<R (*)(A)>
+    {
+        using type = std::remove_cvref_t<A>;
+    };
+
+    template<class C, class R, class A>
+    struct ArgumentOf<R (C::*)(A)> : ArgumentOf<R (*)(A)>
+    {};
+
+    template<class C, class R, class A>
+    struct ArgumentOf<R (C::*)(A) const> : ArgumentOf<R (*)(A)>
+    {};
+
+    template<class C, class R, class A>
+    struct ArgumentOf<R (C::*)(A) noexcept> : ArgumentOf<R (*)(A)>
+    {};
+
+    template<class C, class R, class A>
+    struct ArgumentOf<R (C::*)(A) const noexcept> : ArgumentOf<R (*)(A)>
+    {};
+
+    template<class Function>
+    struct ArgumentOf<Function, std::void_t<decltype(&Function::operator())> >
+        : ArgumentOf<decltype(&Function::operator())>
+    {};
+
+    template<class T>
+    EventArgument EventArgument::make(T value)
+    {
+        if constexpr (BuiltinArgument<T>)
+            return EventArgument(std::move(value));
+        else
+            return EventArgument(Custom{ std::make_shared<const T>(std::move(value)), &typeid(T) });
+    }
+
+    template<class T>
+    bool EventArgument::holds() const noexcept
+    {
+        if constexpr (BuiltinArgument<T>)
+            return std::holds_alternative<T>(_value);
+        else
+        {
+            const auto custom = std::get_if<Custom>(&_value);
+            return custom && *custom->type == typeid(T);
+        }
+    }
+
+    template<class T>
+    const T& EventArgument::get() const
+    {
+        if constexpr (BuiltinArgument<T>)
+            return std::get<T>(_value);
+        else
+        {
+            if (!holds<T>())
+                throw std::bad_variant_access();
+
+            return *static_cast<const T*>(std::get<Custom>(_value).value.get());
+        }
+    }
+} // Scenes
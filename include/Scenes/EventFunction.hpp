@@ -0,0 +1,221 @@
+/**
+ * @file EventFunction.hpp
+ * @brief Contains the EventFunction class along with relevant types and functions.
+ */
+
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+namespace Scenes
+{
+    template<class Signature>
+    class EventFunction;
+
+    /**
+     * @brief A move-only function wrapper that stores small callables inline.
+     *
+     * Unlike std::function, an EventFunction never copies its callable, and stores any callable of up to
+     * @c bufferSize bytes that can be moved without throwing inside itself instead of on the heap. Lambdas capturing
+     * a few references or values, function pointers and std::function objects all fit, so wrapping them allocates
+     * nothing and calling them is a single indirect call.
+     *
+     * @tparam R The return type of the stored callable.
+     * @tparam Args The arguments taken in by the stored callable.
+     */
+    template<class R, class ...Args>
+    class EventFunction<R(Args...)>
+    {
+    public:
+        static constexpr size_t bufferSize = 48; //!< The largest callable stored without allocating.
+
+        EventFunction(const EventFunction&) = delete;
+        EventFunction& operator=(const EventFunction&) = delete;
+
+        /**
+         * @brief Initializes a new, empty instance of the EventFunction class.
+         */
+        EventFunction() noexcept;
+
+        /**
+         * @brief Initializes a new instance of the EventFunction class storing a callable.
+         *
+         * @param function The callable to store.
+         */
+        template<class Function>
+            requires (!std::same_as<std::remove_cvref_t<Function>, EventFunction>
+                      && std::is_invocable_r_v<R, std::decay_t<Function>&, Args...>)
+        EventFunction(
+            Function&& function
+        );
+
+        EventFunction(
+            EventFunction&& other
+        ) noexcept;
+
+        EventFunction& operator=(
+            EventFunction&& other
+        ) noexcept;
+
+        ~EventFunction();
+
+        /**
+         * @brief Calls the stored callable.
+         *
+         * @warning Calling an empty EventFunction causes undefined behaviour.
+         */
+        R operator()(
+            Args ... args
+        );
+
+        /**
+         * @brief Checks if a callable is stored.
+         */
+        explicit operator bool() const noexcept;
+
+        /**
+         * @brief Determine the type of the stored callable.
+         *
+         * @return The type identifier of the stored callable, or typeid(void) if nothing is stored.
+         */
+        [[nodiscard]] const std::type_info& targetType() const noexcept;
+
+    private:
+        /**
+         * @internal The operations of a stored callable type.
+         */
+        struct Operations
+        {
+            R (* invoke)(void* storage, Args&& ... args); //!< @internal Calls the callable.
+            void (* move)(void* from, void* to) noexcept; //!< @internal Moves the callable into empty storage.
+            void (* destroy)(void* storage) noexcept; //!< @internal Destroys the callable.
+            const std::type_info& type; //!< @internal The type of the callable.
+        };
+
+        template<class Function>
+        static constexpr bool storedInline = sizeof(Function) <= bufferSize
+            && alignof(Function) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Function>;
+
+        template<class Function>
+        static Function& target(void* storage) noexcept;
+
+        template<class Function>
+        static constexpr Operations operationsFor{
+            [](void* storage, Args&& ... args) -> R
+            {
+                return static_cast<R>(std::invoke(target<Function>(storage), std::forward<Args>(args)...));
+            },
+            [](void* from, void* to) noexcept
+            {
+                if constexpr (storedInline<Function>)
+                {
+                    ::new(to) Function(std::move(target<Function>(from)));
+                    target<Function>(from).~Function();
+                }
+                else
+                    ::new(to) Function*(*static_cast<Function**>(from));
+            },
+            [](void* storage) noexcept
+            {
+                if constexpr (storedInline<Function>)
+                    target<Function>(storage).~Function();
+                else
+                    delete &target<Function>(storage);
+            },
+            typeid(Function)
+        };
+
+        void reset() noexcept;
+
+        alignas(std::max_align_t) std::byte _storage[bufferSize]; //!< @internal The callable, or a pointer to it.
+        const Operations* _operations; //!< @internal The operations of the callable, or nullptr if empty.
+    };
+
+    template<class R, class ...Args>
+    EventFunction<R(Args...)>::EventFunction() noexcept
+        : _operations(nullptr)
+    {}
+
+    template<class R, class ...Args>
+    template<class Function>
+        requires (!std::same_as<std::remove_cvref_t<Function>, EventFunction<R(Args...)> >
+                  && std::is_invocable_r_v<R, std::decay_t<Function>&, Args...>)
+    EventFunction<R(Args...)>::EventFunction(Function&& function)
+        : _operations(&operationsFor<std::decay_t<Function> >)
+    {
+        using Stored = std::decay_t<Function>;
+
+        if constexpr (storedInline<Stored>)
+            ::new(static_cast<void*>(_storage)) Stored(std::forward<Function>(function));
+        else
+            ::new(static_cast<void*>(_storage)) Stored*(new Stored(std::forward<Function>(function)));
+    }
+
+    template<class R, class ...Args>
+    EventFunction<R(Args...)>::EventFunction(EventFunction&& other) noexcept
+        : _operations(std::exchange(other._operations, nullptr))
+    {
+        if (_operations)
+            _operations->move(other._storage, _storage);
+    }
+
+    template<class R, class ...Args>
+    EventFunction<R(Args...)>& EventFunction<R(Args...)>::operator=(EventFunction&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _operations = std::exchange(other._operations, nullptr);
+            if (_operations)
+                _operations->move(other._storage, _storage);
+        }
+
+        return *this;
+    }
+
+    template<class R, class ...Args>
+    EventFunction<R(Args...)>::~EventFunction()
+    {
+        reset();
+    }
+
+    template<class R, class ...Args>
+    R EventFunction<R(Args...)>::operator()(Args ... args)
+    {
+        return _operations->invoke(_storage, std::forward<Args>(args)...);
+    }
+
+    template<class R, class ...Args>
+    EventFunction<R(Args...)>::operator bool() const noexcept
+    {
+        return _operations != nullptr;
+    }
+
+    template<class R, class ...Args>
+    const std::type_info& EventFunction<R(Args...)>::targetType() const noexcept
+    {
+        return _operations ? _operations->type : typeid(void);
+    }
+
+    template<class R, class ...Args>
+    template<class Function>
+    Function& EventFunction<R(Args...)>::target(void* storage) noexcept
+    {
+        if constexpr (storedInline<Function>)
+            return *std::launder(static_cast<Function*>(storage));
+        else
+            return **std::launder(static_cast<Function**>(storage));
+    }
+
+    template<class R, class ...Args>
+    void EventFunction<R(Args...)>::reset() noexcept
+    {
+        if (_operations)
+            std::exchange(_operations, nullptr)->destroy(_storage);
+    }
+} // Scenes
@@ -5,13 +5,61 @@
 
 #pragma once
 
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "InlineVector.hpp"
 #include "Log.hpp"
 
 namespace Scenes
 {
+	using EventId = std::uint32_t; //!< The interned identifier of an Event name.
+
+    /**
+     * @brief The structured form of an eventString, pairing an interned Event name with a return value.
+     */
+	struct EventKey
+	{
+		EventId id; //!< The interned Event name.
+		int returnValue; //!< The value returned by the Event.
+
+		bool operator==(const EventKey& rhs) const = default;
+	};
+
+    /**
+     * @brief Hashes an EventKey for use in unordered containers.
+     */
+	struct EventKeyHash
+	{
+		[[nodiscard]] size_t operator()(const EventKey& key) const noexcept;
+	};
+
+    /**
+     * @brief Splits an eventString into its Event name and return value.
+     * @relates EventLog
+     *
+     * @param eventString A string of the form "name,returnValue".
+     * @return The name and return value, or an empty optional if eventString isn't exactly the string that
+     * @c createEventString() would produce for them.
+     */
+	[[nodiscard]] std::optional<std::pair<std::string, int> > splitEventString(
+		const std::string& eventString
+	) noexcept;
+
     /**
      * @brief A Log class that stores records of Events that have been run.
-     *     * Event records names are of the form "Event name,return value" and are called eventStrings.
+     *
+     * Event records are stored under an EventKey, made up of an interned Event name and the Event's return value,
+     * so logging an Event never builds or hashes a string. The string form of a record, "Event name,return value", is
+     * called an eventString and is still accepted by the Log interface: eventStrings are converted into keys on the
+     * way in, and any name that isn't a well-formed eventString is stored as-is.
      *
      * @copydetails Scenes::Log
      */
@@ -27,6 +75,270 @@ namespace Scenes
 			const size_t& linesRead
 		) noexcept;
 
+        /**
+         * @brief Gets the id of an Event name, assigning it a new one if the name hasn't been seen before.
+         *
+         * Interning doesn't add any records, so it may be done through a const EventLog.
+         *
+         * @param eventName The name of the Event.
+         * @return The id of eventName.
+         */
+		[[nodiscard]] EventId intern(
+			const std::string& eventName
+		) const;
+
+        /**
+         * @brief Gets the id of an Event name without interning it.
+         *
+         * @param eventName The name of the Event.
+         * @return The id of eventName, or an empty optional if eventName has never been interned.
+         */
+		[[nodiscard]] std::optional<EventId> findId(
+			const std::string& eventName
+		) const noexcept;
+
+        /**
+         * @brief Gets the Event name an id was interned from.
+         *
+         * @warning Passing an id that wasn't returned by this EventLog causes undefined behaviour.
+         *
+         * @param id The interned id.
+         * @return The name of the Event.
+         */
+		[[nodiscard]] const std::string& eventName(
+			EventId id
+		) const noexcept;
+
+        /**
+         * @brief Converts an eventString into an EventKey without interning its name.
+         *
+         * @param eventString The eventString to convert.
+         * @return The matching key, or an empty optional if eventString is malformed or its name has never been
+         * interned.
+         */
+		[[nodiscard]] std::optional<EventKey> findKey(
+			const std::string& eventString
+		) const noexcept;
+
+        /**
+         * @brief Adds a new record or updates the result of an existing record by name.
+         *
+         * If this EventLog is concurrent, the append is queued with the appends of Event keys, so they are applied in
+         * the order they were made.
+         *
+         * @copydetails Scenes::Log::addLog(const LogNameType&)
+         */
+		void addLog(
+			const LogNameType& name
+		) noexcept override;
+
+        /**
+         * @brief Adds a new record or updates the result of an existing record of an Event.
+         *
+         * Like @c Log::addLog(), this only queues the append if this EventLog is concurrent.
+         *
+         * @copydetails Scenes::Log::addLog(const LogNameType&)
+         */
+		void addLog(
+			const EventKey& key
+		) noexcept;
+
+        /**
+         * @brief Adds a record of an Event at a given line instead of the current one.
+         *
+         * Used to log the results of Events that finish after the line that ran them. The record is always added
+         * immediately, even if this EventLog is concurrent, so this must only be called by the thread owning it.
+         *
+         * @param key The key of the record.
+         * @param line The line to log the Event at. A line lower than the last line the record was logged at is
+         * logged as that last line instead, so records stay in ascending order.
+         */
+		void addLog(
+			const EventKey& key,
+			size_t line
+		) noexcept;
+
+        /**
+         * @brief Adds records of several Events at the current line in one pass.
+         *
+         * Has the same effect as calling @c addLog(const EventKey&) for each key, except that equal keys are journaled
+         * together. Each record is looked up once, and the dependents of each Event are raised once, per batch.
+         *
+         * @param keys The keys of the records.
+         */
+		void addLogs(
+			std::span<const EventKey> keys
+		) noexcept;
+
+        /**
+         * @brief Queries this Log for the result vector of an Event.
+         *
+         * @param key The key of the record to query for.
+         * @return A vector containing line numbers of when this record was logged, or an empty vector if the query
+         * fails.
+         */
+		[[nodiscard]] LogResultType query(
+			const EventKey& key
+		) const noexcept;
+
+        /**
+         * @brief Views the result vector of an Event without copying it.
+         *
+         * @warning The view is invalidated by the next call to @c addLog().
+         *
+         * @param key The key of the record to view.
+         * @return A view of the line numbers of when this record was logged, or an empty view if the query fails.
+         */
+		[[nodiscard]] LogView view(
+			const EventKey& key
+		) const noexcept;
+
+        /**
+         * @brief Gets the line number of when an Event was first logged.
+         *
+         * @param key The key of the record.
+         * @return The first logged line number, or an empty optional if the record doesn't exist.
+         */
+		[[nodiscard]] std::optional<size_t> first(
+			const EventKey& key
+		) const noexcept;
+
+        /**
+         * @brief Gets the line number of when an Event was last logged.
+         *
+         * @param key The key of the record.
+         * @return The last logged line number, or an empty optional if the record doesn't exist.
+         */
+		[[nodiscard]] std::optional<size_t> last(
+			const EventKey& key
+		) const noexcept;
+
+        /**
+         * @brief Gets how many times an Event has been logged.
+         *
+         * @param key The key of the record.
+         * @return The number of times the record was logged, which is 0 if it doesn't exist.
+         */
+		[[nodiscard]] size_t count(
+			const EventKey& key
+		) const noexcept;
+
+        /**
+         * @brief Counts how many times an Event was logged within an inclusive range of lines.
+         *
+         * @param key The key of the record.
+         * @param from The first line of the range.
+         * @param to The last line of the range.
+         * @return The number of times the record was logged in [from, to].
+         * @throws DiscardedLogError if the record's retention policy discarded line numbers in the range.
+         */
+		[[nodiscard]] size_t countBetween(
+			const EventKey& key,
+			size_t from,
+			size_t to
+		) const;
+
+        /**
+         * @brief Finds the first time an Event was logged at or after a given line.
+         *
+         * @param key The key of the record.
+         * @param line The line to search from.
+         * @return The first logged line number >= line, or an empty optional if there is none.
+         * @throws DiscardedLogError if the record's retention policy discarded that line number.
+         */
+		[[nodiscard]] std::optional<size_t> firstAtOrAfter(
+			const EventKey& key,
+			size_t line
+		) const;
+
+        /**
+         * @brief Sets the retention policy of every record in this Log, including records added later.
+         *
+         * @copydetails Scenes::Log::setRetention(RetentionPolicy)
+         */
+		void setRetention(
+			RetentionPolicy policy
+		) override;
+
+        /**
+         * @brief Sets the retention policy of every record of an Event, including return values logged later.
+         *
+         * @param id The interned Event name.
+         * @param policy The policy to set.
+         */
+		void setRetention(
+			EventId id,
+			RetentionPolicy policy
+		);
+
+        /**
+         * @brief Raises a flag whenever an Event is logged with any return value, until the flag is destroyed.
+         *
+         * @copydetails Log::addDependent()
+         *
+         * @param id The interned Event name.
+         * @param flag The flag to set to true.
+         */
+		void addDependent(
+			EventId id,
+			std::weak_ptr<bool> flag
+		) const;
+
+		using Log::addLog;
+		using Log::addDependent;
+		using Log::query;
+		using Log::view;
+		using Log::first;
+		using Log::last;
+		using Log::count;
+		using Log::countBetween;
+		using Log::firstAtOrAfter;
+		using Log::setRetention;
+
+        /**
+         * @brief Gets every return value an Event has been logged with, in ascending order.
+         *
+         * @param id The interned Event name.
+         * @return The ordered set of logged return values, which is empty if the Event has never been logged.
+         */
+		[[nodiscard]] const std::set<int>& returnValues(
+			EventId id
+		) const noexcept;
+
+        /**
+         * @brief Gets the lowest value an Event has been logged with.
+         *
+         * @param eventName The name of the Event.
+         * @return The lowest logged return value, or an empty optional if the Event has never been logged.
+         */
+		[[nodiscard]] std::optional<int> lowestReturn(
+			const std::string& eventName
+		) const noexcept;
+
+        /**
+         * @brief Gets the highest value an Event has been logged with.
+         *
+         * @param eventName The name of the Event.
+         * @return The highest logged return value, or an empty optional if the Event has never been logged.
+         */
+		[[nodiscard]] std::optional<int> highestReturn(
+			const std::string& eventName
+		) const noexcept;
+
+        /**
+         * @brief Checks if an Event has been logged with a return value in an inclusive range.
+         *
+         * @param eventName The name of the Event.
+         * @param min The lowest return value to accept.
+         * @param max The highest return value to accept.
+         * @return True if a logged return value of the Event is in [min, max], false otherwise.
+         */
+		[[nodiscard]] bool anyReturnBetween(
+			const std::string& eventName,
+			int min,
+			int max
+		) const noexcept;
+
         /**
          * @brief Finds what eventStrings in this log contain a given Event name.
          * @param eventName The name to search for.
@@ -35,5 +347,154 @@ namespace Scenes
 		[[nodiscard]] std::vector<LogNameType> findKeys(
 			const LogNameType& eventName
 		) const noexcept override;
+
+        /**
+         * @copydoc Scenes::Log::empty()
+         */
+		[[nodiscard]] bool empty() const noexcept override;
+
+        /**
+         * @copydoc Log::memoryUsage()
+         *
+         * Interned Event names and the return values logged for each are counted too.
+         */
+		[[nodiscard]] size_t memoryUsage() const noexcept override;
+
+        /**
+         * @copydoc Log::writeSnapshot()
+         *
+         * Interned Event names are written alongside the records, so that keys can be read back by name.
+         */
+		void writeSnapshot(
+			SnapshotWriter& writer
+		) const override;
+
+        /**
+         * @copydoc Log::readSnapshot()
+         *
+         * Event names in the snapshot are interned into this EventLog rather than replacing its ids, so ids already
+         * held by Events stay valid. Records of eventStrings kept by name are moved into the interned index.
+         */
+		void readSnapshot(
+			SnapshotReader& reader
+		) override;
+
+	protected:
+        /**
+         * @copydoc Scenes::Log::find(const LogNameType&)
+         */
+		[[nodiscard]] const LogRecord* find(
+			const LogNameType& name
+		) const noexcept override;
+
+        /**
+         * @copydoc Scenes::Log::record(const LogNameType&)
+         */
+		[[nodiscard]] LogRecord& record(
+			const LogNameType& name
+		) override;
+
+        /**
+         * @copydoc Scenes::Log::raiseDependents(const LogNameType&)
+         *
+         * Well-formed eventStrings raise the flags depending on their Event.
+         */
+		void raiseDependents(
+			const LogNameType& name
+		) noexcept override;
+
+	private:
+        /**
+         * @brief Adds to the record of an Event, journaling it if a journal is set.
+         *
+         * @param key The key of the record.
+         * @param line The line to log the Event at.
+         */
+		void apply(
+			const EventKey& key,
+			size_t line
+		) noexcept;
+
+		size_t drainAppends() override;
+
+        /**
+         * @brief Moves records whose names are eventStrings out of the records kept by name and into the interned
+         * index, merging them with the records of the same key.
+         *
+         * Snapshots can hold eventStrings kept by name, such as ones logged before Events were interned, which the
+         * return value queries wouldn't see otherwise.
+         */
+		void adoptNamedRecords();
+
+        /**
+         * @brief Finds the stored record of an Event.
+         *
+         * @param key The key of the record.
+         * @return A pointer to the record, or nullptr if the record doesn't exist.
+         */
+		[[nodiscard]] const LogRecord* find(
+			const EventKey& key
+		) const noexcept;
+
+        /**
+         * @brief Finds the stored record of an Event, creating and indexing it if it doesn't exist.
+         *
+         * @param key The key of the record.
+         * @return The record.
+         */
+		[[nodiscard]] LogRecord& record(
+			const EventKey& key
+		);
+
+		using EventLogType = std::unordered_map<EventKey, LogRecord, EventKeyHash>;
+
+		EventLogType _events; //!< The hash table that stores all Event records keyed by EventKey.
+		AppendQueue<std::variant<LogNameType, EventKey> > _queuedAppends; //!< Names and Event keys appended by other
+		                                                                    //!< threads since the last synchronization.
+		mutable std::unordered_map<std::string, EventId> _ids; //!< Maps interned Event names to their ids.
+		mutable std::vector<std::string> _names; //!< Maps interned ids back to their Event names.
+		std::vector<std::set<int> > _returns; //!< Maps interned ids to the return values they were logged with.
+		std::unordered_map<EventId, RetentionPolicy> _eventRetention; //!< Retention policies set per Event name.
+		mutable std::vector<DependentFlags> _eventDependents; //!< Maps interned ids to the flags depending on them.
+	};
+
+    /**
+     * @brief Collects the results of Events run together so they are added to their EventLog in one pass.
+     *
+     * Results are added when the batch is committed or destroyed. Results for a different EventLog than the
+     * previous ones commit the batch first, so every result is still added in the order it was collected.
+     */
+	class EventBatch
+	{
+	public:
+		EventBatch(const EventBatch&) = delete;
+		EventBatch& operator=(const EventBatch&) = delete;
+
+		EventBatch() noexcept = default;
+
+        /**
+         * @brief Commits the collected results.
+         */
+		~EventBatch();
+
+        /**
+         * @brief Collects the result of an Event.
+         *
+         * @param eventLog The EventLog the result is added to.
+         * @param key The key of the record.
+         */
+		void add(
+			EventLog& eventLog,
+			const EventKey& key
+		);
+
+        /**
+         * @brief Adds every collected result to its EventLog.
+         */
+		void commit() noexcept;
+
+	private:
+		EventLog* _eventLog = nullptr; //!< The EventLog of the collected results.
+		InlineVector<EventKey, 4> _keys; //!< The collected results, in the order they were collected.
 	};
 } // Scenes
@@ -0,0 +1,196 @@
+/**
+ * @file EventMap.hpp
+ * @brief Contains the EventMap class along with relevant types and functions.
+ */
+
+#pragma once
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Event.hpp"
+#include "EventArgument.hpp"
+#include "EventLog.hpp"
+#include "EventRegistry.hpp"
+
+namespace Scenes
+{
+    using LineEvent = Event<const EventArgument&>; //!< The kind of Event that Lines run.
+
+    /**
+     * @brief Stores the Events that Lines can run, addressed by a dense EventIndex as well as by name.
+     *
+     * Events are kept in a single array in the order they were added, so running an Event whose index is known is an
+     * array access. Names are only looked up to find an index, which Lines do once when they are linked.
+     *
+     * An EventMap built from an EventRegistry holds the registered Events first, at the indices the registry assigns
+     * them at compile time. Events added by name take the next free indices.
+     *
+     * Every Event may have an ArgumentParser, which Lines use to parse their event argument once when they are linked.
+     * Events without one receive the argument text as a string.
+     *
+     * @warning Adding an Event may move every Event in the map, invalidating references and pointers to them. Indices
+     * stay valid.
+     */
+    class EventMap
+    {
+    public:
+        static constexpr EventIndex noEvent = std::numeric_limits<EventIndex>::max(); //!< The index of no Event.
+
+        /**
+         * @brief Initializes a new, empty instance of the EventMap class.
+         */
+        EventMap() noexcept = default;
+
+        /**
+         * @brief Initializes a new instance of the EventMap class holding every Event of a registry.
+         *
+         * @param registry The registry whose tags are constructed into Events, in index order.
+         * @param eventLog The eventLog the registered Events log to.
+         */
+        template<class ...Tags>
+        EventMap(
+            EventRegistry<Tags...> registry,
+            EventLog& eventLog
+        );
+
+        /**
+         * @brief Adds an Event if no Event with the same name exists.
+         *
+         * @param name The name of the Event.
+         * @param func The functor the Event runs, taking either a const EventArgument& or the argument text as a
+         * std::string.
+         * @param eventLog The eventLog the Event logs to.
+         * @param parser Parses the arguments of the Event, or is empty if they are passed on as text.
+         * @param logging Whether calls are logged by the Event.
+         * @return The index of the Event with that name, and whether it was added.
+         */
+        template<class Function>
+            requires std::is_invocable_r_v<int, std::decay_t<Function>&, const EventArgument&>
+                     || std::is_invocable_r_v<int, std::decay_t<Function>&, std::string>
+        std::pair<EventIndex, bool> emplace(
+            const std::string& name,
+            Function&& func,
+            EventLog& eventLog,
+            ArgumentParser parser = {},
+            EventLogging logging = EventLogging::OnCall
+        );
+
+        /**
+         * @brief Parses the text of an argument for an Event.
+         *
+         * @warning Passing an index of @c size() or more causes undefined behaviour.
+         *
+         * @param index The index of the Event.
+         * @param text The text of the argument.
+         * @return The argument parsed by the Event's ArgumentParser, or text if the Event has none.
+         * @throws EventArgumentError or any exception thrown by the parser if text can't be parsed.
+         */
+        [[nodiscard]] EventArgument parse(
+            EventIndex index,
+            const std::string& text
+        ) const;
+
+        /**
+         * @brief Finds the index of an Event by name.
+         *
+         * @param name The name of the Event.
+         * @return The index of the Event, or an empty optional if this map doesn't contain it.
+         */
+        [[nodiscard]] std::optional<EventIndex> find(
+            const std::string& name
+        ) const noexcept;
+
+        /**
+         * @brief Gets an Event by name.
+         *
+         * @param name The name of the Event.
+         * @return The Event.
+         * @throws std::out_of_range if this map doesn't contain the Event.
+         */
+        [[nodiscard]] LineEvent& at(
+            const std::string& name
+        );
+
+        /**
+         * @copydoc at(const std::string&)
+         */
+        [[nodiscard]] const LineEvent& at(
+            const std::string& name
+        ) const;
+
+        /**
+         * @brief Gets an Event by index.
+         *
+         * @warning Passing an index of @c size() or more causes undefined behaviour.
+         *
+         * @param index The index of the Event.
+         * @return The Event.
+         */
+        [[nodiscard]] LineEvent& operator[](
+            EventIndex index
+        ) noexcept;
+
+        /**
+         * @copydoc operator[](EventIndex)
+         */
+        [[nodiscard]] const LineEvent& operator[](
+            EventIndex index
+        ) const noexcept;
+
+        [[nodiscard]] bool contains(
+            const std::string& name
+        ) const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+    private:
+        std::vector<LineEvent> _events; //!< Every Event, stored at its index.
+        std::vector<ArgumentParser> _parsers; //!< The ArgumentParser of every Event, stored at its index.
+        std::unordered_map<std::string, EventIndex> _indices; //!< Maps Event names to their indices.
+    };
+
+    template<class ...Tags>
+    EventMap::EventMap(EventRegistry<Tags...>, EventLog& eventLog)
+    {
+        _events.reserve(sizeof...(Tags));
+        _parsers.reserve(sizeof...(Tags));
+        (emplace(std::string(Tags::name), Tags{}, eventLog), ...);
+    }
+
+    template<class Function>
+        requires std::is_invocable_r_v<int, std::decay_t<Function>&, const EventArgument&>
+                 || std::is_invocable_r_v<int, std::decay_t<Function>&, std::string>
+    std::pair<EventIndex, bool> EventMap::emplace(
+        const std::string& name, Function&& func, EventLog& eventLog, ArgumentParser parser, EventLogging logging)
+    {
+        const auto index = static_cast<EventIndex>(_events.size());
+        const auto [found, added] = _indices.try_emplace(name, index);
+        if (!added)
+            return { found->second, false };
+
+        try
+        {
+            if constexpr (std::is_invocable_r_v<int, std::decay_t<Function>&, const EventArgument&>)
+                _events.emplace_back(std::forward<Function>(func), name, eventLog, logging);
+            else
+                _events.emplace_back([func = std::forward<Function>(func)](const EventArgument& arg) mutable -> int {
+                    return func(arg.get<std::string>());
+                }, name, eventLog, logging);
+            _parsers.push_back(std::move(parser));
+        } catch (...)
+        {
+            if (_events.size() > index)
+                _events.pop_back();
+            _indices.erase(found);
+            throw;
+        }
+
+        return { index, true };
+    }
+} // Scenes
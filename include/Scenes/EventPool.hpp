@@ -0,0 +1,103 @@
+/**
+ * @file EventPool.hpp
+ * @brief Contains the EventPool class along with relevant types and functions.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "EventFunction.hpp"
+
+namespace Scenes
+{
+    /**
+     * @brief A fixed set of worker threads running tasks from a bounded queue.
+     *
+     * Tasks run in the order they were submitted, spread over the workers. Once @c capacity tasks are waiting,
+     * submitting another blocks until a worker takes one, so a thread submitting faster than the workers can keep up
+     * is slowed down instead of queuing without bound.
+     */
+    class EventPool
+    {
+    public:
+        EventPool(const EventPool&) = delete;
+        EventPool& operator=(const EventPool&) = delete;
+
+        /**
+         * @brief Starts the worker threads of a new instance of the EventPool class.
+         *
+         * @param workers The number of worker threads, which is raised to 1 if it is 0.
+         * @param capacity The number of tasks that may wait for a worker, which is raised to 1 if it is 0.
+         */
+        EventPool(
+            size_t workers,
+            size_t capacity
+        );
+
+        /**
+         * @brief Runs every submitted task, then stops the worker threads.
+         */
+        ~EventPool();
+
+        /**
+         * @brief Queues a task to be run by a worker, blocking while the queue is full.
+         *
+         * @param task The task to run. Exceptions thrown by it are ignored, so tasks should catch their own.
+         */
+        void submit(
+            EventFunction<void()> task
+        );
+
+        /**
+         * @brief Gets the number of worker threads.
+         */
+        [[nodiscard]] size_t workers() const noexcept;
+
+    private:
+        void stop() noexcept;
+        void workLoop() noexcept;
+
+        const size_t _capacity; //!< The number of tasks that may wait for a worker.
+
+        std::mutex _mutex; //!< @internal Guards every member below it.
+        std::condition_variable _taskReady; //!< @internal Wakes workers when a task is queued or the pool stops.
+        std::condition_variable _spaceReady; //!< @internal Wakes submitters when a worker takes a task.
+        std::deque<EventFunction<void()> > _tasks; //!< @internal The tasks waiting for a worker.
+        bool _stopping; //!< @internal Whether the pool is being destroyed.
+
+        std::vector<std::thread> _threads; //!< @internal The workers. Started last, so every member is ready.
+    };
+
+    /**
+     * @brief Marks a callable as an asynchronous Event when it is added to a Reader.
+     *
+     * @tparam Function The callable, taking the same arguments as one given to @c Reader::addEvent().
+     */
+    template<class Function>
+    struct AsyncEvent
+    {
+        Function function; //!< The callable run on the Reader's EventPool.
+    };
+
+    /**
+     * @brief Marks a callable as an asynchronous Event, to be passed to @c Reader::addEvent().
+     * @relates AsyncEvent
+     *
+     * @param function The callable to run on a worker thread.
+     * @return The marked callable.
+     */
+    template<class Function>
+    [[nodiscard]] AsyncEvent<std::decay_t<Function> > asyncEvent(
+        Function&& function
+    )
+    {
+        return { std::forward<Function>(function) };
+    }
+} // Scenes
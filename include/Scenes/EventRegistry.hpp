@@ -0,0 +1,112 @@
+/**
+ * @file EventRegistry.hpp
+ * @brief Contains the EventRegistry class along with relevant types and functions.
+ */
+
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "EventArgument.hpp"
+
+namespace Scenes
+{
+    using EventIndex = std::uint32_t; //!< The position of an Event in an EventMap.
+
+    /**
+     * @brief A type that can be registered as an Event at compile time.
+     *
+     * An Event tag is a default-constructible functor taking the Line's event argument, either as a const
+     * EventArgument& or as text, and returning an int. It has a static @c name member holding the Event name Lines
+     * refer to it by. For example:
+     *
+     * @code
+     * struct AddGold
+     * {
+     *     static constexpr std::string_view name = "addGold";
+     *     int operator()(const std::string& amount) const;
+     * };
+     * @endcode
+     */
+    template<class Tag>
+    concept EventTag = std::default_initializable<Tag>
+                       && (std::is_invocable_r_v<int, Tag&, const EventArgument&>
+                           || std::is_invocable_r_v<int, Tag&, std::string>)
+                       && requires { { Tag::name } -> std::convertible_to<std::string_view>; };
+
+    /**
+     * @internal Checks that no two names in an array are equal.
+     */
+    template<size_t Size>
+    consteval bool uniqueNames(const std::array<std::string_view, Size>& names) noexcept
+    {
+        for (size_t i = 0; i < Size; i++)
+            for (size_t j = i + 1; j < Size; j++)
+                if (names[i] == names[j])
+                    return false;
+
+        return true;
+    }
+
+    /**
+     * @brief A compile-time list of Events, each assigned a dense EventIndex by its position in the list.
+     *
+     * An EventMap built from a registry holds its Events at exactly the indices given by @c id, so code knowing an
+     * Event's tag can reach it with an array index instead of a name lookup. Events added to the EventMap by name
+     * afterwards are placed after the registered ones.
+     *
+     * Tags and their names must be unique within a registry, which is checked at compile time.
+     *
+     * @tparam Tags The Event tags, in index order.
+     */
+    template<EventTag ...Tags>
+    class EventRegistry
+    {
+    public:
+        static constexpr size_t size = sizeof...(Tags); //!< The number of registered Events.
+        static constexpr std::array<std::string_view, size> names{ std::string_view(Tags::name)... }; //!< By index.
+
+        /**
+         * @brief The index of the Event registered under a tag.
+         *
+         * @tparam Tag A tag in this registry.
+         */
+        template<class Tag>
+        static constexpr EventIndex id = []
+        {
+            static_assert((std::is_same_v<Tag, Tags> || ...), "Tag is not part of this EventRegistry.");
+
+            EventIndex index = 0;
+            ((std::is_same_v<Tag, Tags> ? false : (index++, true)) && ...);
+            return index;
+        }();
+
+        /**
+         * @brief Finds the index of a registered Event by name.
+         *
+         * @param name The name of the Event.
+         * @return The index of the Event, or an empty optional if no registered Event has that name.
+         */
+        [[nodiscard]] static constexpr std::optional<EventIndex> find(
+            std::string_view name
+        ) noexcept;
+
+        // Two uses of one tag would share a name, so unique names mean unique tags as well.
+        static_assert(uniqueNames(names), "Every tag and Event name in an EventRegistry must be unique.");
+    };
+
+    template<EventTag ...Tags>
+    constexpr std::optional<EventIndex> EventRegistry<Tags...>::find(std::string_view name) noexcept
+    {
+        for (EventIndex index = 0; index < size; index++)
+            if (names[index] == name)
+                return index;
+
+        return {};
+    }
+} // Scenes
@@ -0,0 +1,417 @@
+/**
+ * @file InlineVector.hpp
+ * @brief Contains the InlineVector class along with relevant types and functions.
+ */
+
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Scenes
+{
+    /**
+     * @brief A vector storing its first few values inside itself.
+     *
+     * Up to @c N values are stored in a buffer inside the InlineVector, so holding that many never allocates. Adding
+     * more moves every value to the heap, after which the InlineVector grows like a std::vector.
+     *
+     * @warning Adding a value may move every value, invalidating references, pointers and iterators to them. Moving
+     * an InlineVector whose values are stored inside it moves each of its values.
+     *
+     * @tparam T The type of the stored values.
+     * @tparam N The number of values stored inside the InlineVector.
+     */
+    template<class T, size_t N>
+    class InlineVector
+    {
+        static_assert(N > 0, "An InlineVector must store at least one value inline.");
+
+    public:
+        using value_type = T;
+        using size_type = size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        /**
+         * @brief Initializes a new, empty instance of the InlineVector class.
+         */
+        InlineVector() noexcept;
+
+        /**
+         * @brief Initializes a new instance of the InlineVector class holding copies of some values.
+         *
+         * @param values The values to copy, in order.
+         */
+        InlineVector(
+            std::initializer_list<T> values
+        );
+
+        InlineVector(
+            const InlineVector& other
+        );
+
+        InlineVector(
+            InlineVector&& other
+        ) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        InlineVector& operator=(
+            const InlineVector& other
+        );
+
+        InlineVector& operator=(
+            InlineVector&& other
+        ) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        ~InlineVector();
+
+        /**
+         * @brief Constructs a value at the end of this InlineVector.
+         *
+         * @param args The arguments to construct the value with.
+         * @return The constructed value.
+         */
+        template<class ...Args>
+        T& emplace_back(
+            Args&& ...args
+        );
+
+        /**
+         * @brief Copies or moves a value to the end of this InlineVector.
+         *
+         * @param value The value to add.
+         */
+        template<class Value> requires std::constructible_from<T, Value&&>
+        void push_back(
+            Value&& value
+        );
+
+        /**
+         * @brief Makes room for a number of values, so adding up to that many doesn't move any value.
+         *
+         * @param capacity The number of values to make room for.
+         */
+        void reserve(
+            size_t capacity
+        );
+
+        /**
+         * @brief Destroys every value, keeping the storage they were held in.
+         */
+        void clear() noexcept;
+
+        [[nodiscard]] T& operator[](
+            size_t index
+        ) noexcept;
+
+        [[nodiscard]] const T& operator[](
+            size_t index
+        ) const noexcept;
+
+        [[nodiscard]] T* data() noexcept;
+        [[nodiscard]] const T* data() const noexcept;
+
+        [[nodiscard]] iterator begin() noexcept;
+        [[nodiscard]] const_iterator begin() const noexcept;
+        [[nodiscard]] iterator end() noexcept;
+        [[nodiscard]] const_iterator end() const noexcept;
+
+        [[nodiscard]] size_t size() const noexcept;
+        [[nodiscard]] size_t capacity() const noexcept;
+        [[nodiscard]] bool empty() const noexcept;
+
+        /**
+         * @brief Checks if this InlineVector's values are stored inside it.
+         */
+        [[nodiscard]] bool isInline() const noexcept;
+
+        bool operator==(
+            const InlineVector& rhs
+        ) const requires std::equality_comparable<T>;
+
+    private:
+        [[nodiscard]] T* inlineData() noexcept;
+
+        /**
+         * @internal Moves every value into newly allocated storage.
+         */
+        void reallocate(
+            size_t capacity
+        );
+
+        /**
+         * @internal Frees heap storage, if any, and returns to the inline buffer. Expects no values to be held.
+         */
+        void release() noexcept;
+
+        /**
+         * @internal Takes the values of another InlineVector. Expects this InlineVector to be empty and inline.
+         */
+        void take(
+            InlineVector&& other
+        ) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+        alignas(T) std::byte _buffer[sizeof(T) * N]; //!< @internal Stores the first N values.
+        T* _data; //!< @internal Points to _buffer or to heap storage.
+        size_t _size; //!< @internal The number of values held.
+        size_t _capacity; //!< @internal The number of values _data has room for.
+    };
+
+    template<class T, size_t N>
+    InlineVector<T, N>::InlineVector() noexcept
+        : _data(inlineData()), _size(0), _capacity(N)
+    {}
+
+    template<class T, size_t N>
+    InlineVector<T, N>::InlineVector(std::initializer_list<T> values)
+        : InlineVector()
+    {
+        reserve(values.size());
+        for (const auto& value : values)
+            emplace_back(value);
+    }
+
+    template<class T, size_t N>
+    InlineVector<T, N>::InlineVector(const InlineVector& other)
+        : InlineVector()
+    {
+        reserve(other._size);
+        for (const auto& value : other)
+            emplace_back(value);
+    }
+
+    template<class T, size_t N>
+    InlineVector<T, N>::InlineVector(InlineVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : InlineVector()
+    {
+        take(std::move(other));
+    }
+
+    template<class T, size_t N>
+    InlineVector<T, N>& InlineVector<T, N>::operator=(const InlineVector& other)
+    {
+        if (this != &other)
+            *this = InlineVector(other);
+        return *this;
+    }
+
+    template<class T, size_t N>
+    InlineVector<T, N>& InlineVector<T, N>::operator=(InlineVector&& other)
+        noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other)
+        {
+            clear();
+            release();
+            take(std::move(other));
+        }
+        return *this;
+    }
+
+    template<class T, size_t N>
+    InlineVector<T, N>::~InlineVector()
+    {
+        clear();
+        release();
+    }
+
+    template<class T, size_t N>
+    template<class ...Args>
+    T& InlineVector<T, N>::emplace_back(Args&& ...args)
+    {
+        if (_size < _capacity)
+        {
+            T& value = *std::construct_at(_data + _size, std::forward<Args>(args)...);
+            _size++;
+            return value;
+        }
+
+        // Construct the new value before moving the others, as args may refer to one of them.
+        const auto capacity = _capacity * 2;
+        T* data = std::allocator<T>().allocate(capacity);
+        try
+        {
+            std::construct_at(data + _size, std::forward<Args>(args)...);
+        } catch (...)
+        {
+            std::allocator<T>().deallocate(data, capacity);
+            throw;
+        }
+
+        try
+        {
+            std::uninitialized_move(begin(), end(), data);
+        } catch (...)
+        {
+            std::destroy_at(data + _size);
+            std::allocator<T>().deallocate(data, capacity);
+            throw;
+        }
+
+        const auto size = _size;
+        clear();
+        release();
+        _data = data;
+        _size = size + 1;
+        _capacity = capacity;
+
+        return _data[size];
+    }
+
+    template<class T, size_t N>
+    template<class Value> requires std::constructible_from<T, Value&&>
+    void InlineVector<T, N>::push_back(Value&& value)
+    {
+        emplace_back(std::forward<Value>(value));
+    }
+
+    template<class T, size_t N>
+    void InlineVector<T, N>::reserve(size_t capacity)
+    {
+        if (capacity > _capacity)
+            reallocate(capacity);
+    }
+
+    template<class T, size_t N>
+    void InlineVector<T, N>::clear() noexcept
+    {
+        std::destroy(begin(), end());
+        _size = 0;
+    }
+
+    template<class T, size_t N>
+    T& InlineVector<T, N>::operator[](size_t index) noexcept
+    {
+        return _data[index];
+    }
+
+    template<class T, size_t N>
+    const T& InlineVector<T, N>::operator[](size_t index) const noexcept
+    {
+        return _data[index];
+    }
+
+    template<class T, size_t N>
+    T* InlineVector<T, N>::data() noexcept
+    {
+        return _data;
+    }
+
+    template<class T, size_t N>
+    const T* InlineVector<T, N>::data() const noexcept
+    {
+        return _data;
+    }
+
+    template<class T, size_t N>
+    typename InlineVector<T, N>::iterator InlineVector<T, N>::begin() noexcept
+    {
+        return _data;
+    }
+
+    template<class T, size_t N>
+    typename InlineVector<T, N>::const_iterator InlineVector<T, N>::begin() const noexcept
+    {
+        return _data;
+    }
+
+    template<class T, size_t N>
+    typename InlineVector<T, N>::iterator InlineVector<T, N>::end() noexcept
+    {
+        return _data + _size;
+    }
+
+    template<class T, size_t N>
+    typename InlineVector<T, N>::const_iterator InlineVector<T, N>::end() const noexcept
+    {
+        return _data + _size;
+    }
+
+    template<class T, size_t N>
+    size_t InlineVector<T, N>::size() const noexcept
+    {
+        return _size;
+    }
+
+    template<class T, size_t N>
+    size_t InlineVector<T, N>::capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    template<class T, size_t N>
+    bool InlineVector<T, N>::empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    template<class T, size_t N>
+    bool InlineVector<T, N>::isInline() const noexcept
+    {
+        return _data == reinterpret_cast<const T*>(_buffer);
+    }
+
+    template<class T, size_t N>
+    bool InlineVector<T, N>::operator==(const InlineVector& rhs) const requires std::equality_comparable<T>
+    {
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    template<class T, size_t N>
+    T* InlineVector<T, N>::inlineData() noexcept
+    {
+        return std::launder(reinterpret_cast<T*>(_buffer));
+    }
+
+    template<class T, size_t N>
+    void InlineVector<T, N>::reallocate(size_t capacity)
+    {
+        T* data = std::allocator<T>().allocate(capacity);
+        try
+        {
+            std::uninitialized_move(begin(), end(), data);
+        } catch (...)
+        {
+            std::allocator<T>().deallocate(data, capacity);
+            throw;
+        }
+
+        const auto size = _size;
+        clear();
+        release();
+        _data = data;
+        _size = size;
+        _capacity = capacity;
+    }
+
+    template<class T, size_t N>
+    void InlineVector<T, N>::release() noexcept
+    {
+        if (!isInline())
+            std::allocator<T>().deallocate(_data, _capacity);
+
+        _data = inlineData();
+        _capacity = N;
+    }
+
+    template<class T, size_t N>
+    void InlineVector<T, N>::take(InlineVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (!other.isInline())
+        {
+            _data = std::exchange(other._data, other.inlineData());
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, N);
+            return;
+        }
+
+        std::uninitialized_move(other.begin(), other.end(), _data);
+        _size = other._size;
+        other.clear();
+    }
+} // Scenes
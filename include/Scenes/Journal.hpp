@@ -0,0 +1,206 @@
+/**
+ * @file Journal.hpp
+ * @brief Contains the Journal class along with relevant types and functions.
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "EventLog.hpp"
+
+namespace Scenes
+{
+    /**
+     * @brief Thrown when a Journal can't be opened, written or replayed.
+     */
+    class JournalError : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    /**
+     * @brief Decides when a Journal asks the operating system to flush its writes to disk.
+     */
+    enum class JournalSync
+    {
+        Never, //!< Leave flushing to the operating system, except when @c Journal::flush() is called.
+        Periodic, //!< Flush at most once every @c JournalOptions::syncInterval.
+        EveryCommit //!< Flush after every group commit.
+    };
+
+    /**
+     * @brief Configures how a Journal batches and flushes its writes.
+     */
+    struct JournalOptions
+    {
+        JournalSync sync = JournalSync::EveryCommit; //!< When written records are flushed to disk.
+        std::chrono::milliseconds commitDelay{ 2 }; //!< How long a commit waits to gather more records.
+        std::chrono::milliseconds syncInterval{ 100 }; //!< The time between flushes for JournalSync::Periodic.
+    };
+
+    /**
+     * @brief A single record read back from a Journal.
+     */
+    struct JournalEntry
+    {
+        enum class Kind : std::uint8_t
+        {
+            Name, //!< A name was logged to the Log journaling on @c channel.
+            Event, //!< An Event was logged under @c key. @c name holds the Event's name.
+            Line, //!< A Line was read, bringing the line count to @c line.
+            SectionEnd //!< The Section being read was finished.
+        };
+
+        Kind kind; //!< What was recorded.
+        std::uint8_t channel; //!< The channel of the Log a Name was logged to.
+        size_t line; //!< The line number the record was logged at.
+        EventKey key; //!< The key of an Event, using the ids of the journaling EventLog.
+        std::string_view name; //!< The logged name, or the Event name of an Event. Only valid during replay.
+    };
+
+    /**
+     * @brief An append-only write-ahead journal of log records.
+     *
+     * Records are encoded into a compact in-memory batch by the thread appending them, so appending never touches the
+     * disk. A background thread writes batches to the end of the journal file as group commits, each framed with its
+     * size and a checksum, and flushes them to disk according to a JournalSync policy. Replaying a journal stops at
+     * the first incomplete or corrupted commit, so a crash during a write only loses that commit.
+     *
+     * Line numbers are stored as deltas from the previous record of a commit, and Event names are written once per
+     * journal the first time an Event is logged, so most records take a handful of bytes.
+     */
+    class Journal
+    {
+    public:
+        Journal(const Journal&) = delete;
+        Journal& operator=(const Journal&) = delete;
+
+        /**
+         * @brief Opens a journal file for appending, creating it if it doesn't exist.
+         *
+         * A commit cut short or corrupted by a crash is cut off the end of the file first, along with anything after
+         * it, so new commits aren't hidden behind it from replay().
+         *
+         * @param path The journal file.
+         * @param options How writes are batched and flushed.
+         * @throws JournalError if the file can't be opened or its complete commits can't be read.
+         */
+        explicit Journal(
+            const std::filesystem::path& path,
+            JournalOptions options = {}
+        );
+
+        /**
+         * @brief Commits and flushes every appended record, then closes the journal.
+         */
+        ~Journal();
+
+        /**
+         * @brief Records that a name was logged.
+         *
+         * @param channel Identifies the Log the name was logged to.
+         * @param line The line number the name was logged at.
+         * @param name The logged name.
+         */
+        void logName(
+            std::uint8_t channel,
+            size_t line,
+            const std::string& name
+        ) noexcept;
+
+        /**
+         * @brief Records that an Event was logged.
+         *
+         * @param line The line number the Event was logged at.
+         * @param key The key the Event was logged under.
+         * @param name The Event's name, written only the first time its id is journaled.
+         */
+        void logEvent(
+            size_t line,
+            const EventKey& key,
+            const std::string& name
+        ) noexcept;
+
+        /**
+         * @brief Records reading progress.
+         *
+         * @param kind Either JournalEntry::Kind::Line or JournalEntry::Kind::SectionEnd.
+         * @param line The current line number.
+         */
+        void logProgress(
+            JournalEntry::Kind kind,
+            size_t line
+        ) noexcept;
+
+        /**
+         * @brief Waits until every record appended so far is written and flushed to disk.
+         *
+         * @throws JournalError if a write has failed since the journal was opened.
+         */
+        void flush();
+
+        /**
+         * @brief Flushes, then empties the journal file, usually after its records have been saved in a snapshot.
+         *
+         * @throws JournalError if the journal can't be written or emptied.
+         */
+        void clear();
+
+        /**
+         * @brief Reads every complete commit of a journal file in order.
+         *
+         * Reading stops at the first commit cut short or corrupted by a crash.
+         *
+         * @param path The journal file.
+         * @param handler Called with every record read.
+         * @return The offset just past the last complete commit, or 0 if the file has none.
+         * @throws JournalError if the file exists but can't be read.
+         */
+        static size_t replay(
+            const std::filesystem::path& path,
+            const std::function<void(const JournalEntry&)>& handler
+        );
+
+    private:
+        /**
+         * @internal Encodes a record into the pending batch and wakes the commit thread.
+         */
+        template<class Encode>
+        void append(Encode&& encode) noexcept;
+
+        void commitLoop();
+        void writeFile(const std::vector<std::uint8_t>& bytes);
+        void syncFile();
+
+        const JournalOptions _options; //!< How writes are batched and flushed.
+        int _file; //!< The descriptor of the journal file.
+
+        std::mutex _mutex; //!< @internal Guards every member below it.
+        std::condition_variable _wake; //!< @internal Wakes the commit thread.
+        std::condition_variable _committed; //!< @internal Wakes threads waiting in @c flush().
+        std::vector<std::uint8_t> _pending; //!< @internal The encoded records waiting to be committed.
+        size_t _pendingLine; //!< @internal The line number of the last pending record.
+        std::vector<bool> _defined; //!< @internal Which Event ids have had their names journaled.
+        std::uint64_t _appended; //!< @internal The number of records appended.
+        std::uint64_t _written; //!< @internal The number of records written to the file.
+        std::uint64_t _synced; //!< @internal The number of records flushed to disk.
+        bool _syncRequested; //!< @internal Whether a @c flush() is waiting for the next commit.
+        bool _stopping; //!< @internal Whether the journal is closing.
+        bool _failed; //!< @internal Whether a write or flush has failed.
+
+        std::mutex _fileMutex; //!< @internal Held while the file is written or emptied.
+        std::uint64_t _generation; //!< @internal The number of times the file was emptied. Guarded by both mutexes.
+        std::thread _thread; //!< @internal The commit thread. Started last, so every member is ready.
+    };
+} // Scenes
@@ -8,13 +8,47 @@
 #include <optional>
 
 #include "Event.hpp"
+#include "EventMap.hpp"
+#include "InlineVector.hpp"
 
 namespace Scenes
 {
-    using EventMap = std::unordered_map<std::string, Event<std::string> >;
+    /**
+     * @brief An Event run by a Line, along with the argument it is run with.
+     */
+    struct EventCall
+    {
+        /**
+         * @brief Initializes a new instance of the EventCall struct.
+         *
+         * @param name The name of the Event.
+         * @param arg The argument the Event will take. Should be "" if the Event takes no arguments.
+         */
+        EventCall(
+            std::string name,
+            std::string arg = ""
+        );
+
+        std::string name; //!< The name of the Event.
+        std::string arg; //!< The argument text the Event takes.
+        EventArgument argument; //!< arg as parsed for the Event resolved by @c Line::link().
+        EventIndex index; //!< The index of the Event resolved by @c Line::link(), or EventMap::noEvent if none was.
+
+        /**
+         * @brief Compares the Event names and argument texts of two calls.
+         */
+        bool operator==(const EventCall& rhs) const;
+    };
 
     /**
-     * @brief Contains a text string and an associated Event that is run when the string is read.
+     * @brief The Events of a Line. Most Lines have at most one, which is stored without allocating.
+     */
+    using EventCalls = InlineVector<EventCall, 1>;
+
+    /**
+     * @brief Contains a text string and the Events that are run when the string is read.
+     *
+     * A Line runs its Events in order, and their results are logged together once every Event has run.
      */
     class Line
     {
@@ -33,6 +67,17 @@ namespace Scenes
             std::string eventArg
         );
 
+        /**
+         * @brief Initializes an instance of the Line class running any number of Events.
+         *
+         * @param text The text contained by this Line.
+         * @param events The Events this Line runs, in order.
+         */
+        Line(
+            std::string text,
+            EventCalls events
+        );
+
         /**
          * @brief Initializes an instance of the Line class without an Event.
          * @param text The text contained by this line.
@@ -42,39 +87,93 @@ namespace Scenes
         );
 
         /**
-         * @brief Prints this Line's text to a output stream and runs its Event if it exists in the given Event Map.
+         * @brief Prints this Line's text to a output stream and runs each of its Events that exists in the given Event
+         * Map.
+         *
+         * The results of the Events are logged in one batch after the last one has run. An unlinked Line parses its
+         * arguments on every read, and skips any Event whose argument can't be parsed.
          * @param stream The output steam that is printed to.
          */
         void readLine(
             std::ostream& stream,
             EventMap& events
+        ) const;
+
+        /**
+         * @brief Resolves this Line's Event names to indices and parses their arguments once, so reading this Line
+         * needs no lookup or parsing.
+         *
+         * Once linked, @c readLine() runs the Events at the resolved indices of the Event Map it is given with the
+         * parsed arguments. Events that weren't found are skipped.
+         *
+         * @warning A linked Line must be read with an Event Map holding the same Events at the same indices, which is
+         * any Event Map that only had Events added to it since.
+         *
+         * @param events The Event Map to resolve this Line's Events in.
+         * @return False if this Line has an Event name that events doesn't contain, true otherwise.
+         * @throws EventArgumentError if one of this Line's arguments can't be parsed by its Event's ArgumentParser.
+         * The Line is left unlinked.
+         */
+        bool link(
+            const EventMap& events
         );
 
         /**
-         * @brief Gets this Line's possibly contained Event name.
+         * @brief Checks if @c link() has been called on this Line.
+         */
+        [[nodiscard]] bool linked() const noexcept;
+
+        /**
+         * @brief Gets the Events this Line runs, in order.
+         */
+        [[nodiscard]] const EventCalls& events() const noexcept;
+
+        /**
+         * @brief Gets the index of this Line's first Event as resolved by @c link().
+         *
+         * @return The index of the Event, or EventMap::noEvent if this Line isn't linked, has no Event, or its Event
+         * wasn't found.
+         */
+        [[nodiscard]] EventIndex eventId() const noexcept;
+
+        /**
+         * @brief Gets the name of this Line's first Event.
          * @return An optional that may or may not contain the Event name of this line.
          */
-        [[nodiscard]] const std::optional<std::string>& eventName() const noexcept;
+        [[nodiscard]] std::optional<std::string> eventName() const;
 
         /**
-         * @brief Gets this Line's possibly contained Event.
+         * @brief Gets this Line's possibly contained first Event.
          *
-         * References the given Event Map to find which Event this Line's contained Event name references.
-         * If the Event Map doesn't contain the found event, returns an Optional Event with no event stored.
+         * References the given Event Map to find which Event this Line's first Event name references.
          *
          * @param events The Event Map to query an event for.
-         * @return An optional that may or may not contain the Event of this line.
+         * @return A pointer to the Event of this line in events, or nullptr if this Line has no Event or events doesn't
+         * contain it.
          */
-        [[nodiscard]] std::optional<Event<std::string> > event(
+        [[nodiscard]] LineEvent* event(
+          EventMap& events
+        ) const noexcept;
+
+        /**
+         * @copydoc event(EventMap&) const
+         */
+        [[nodiscard]] const LineEvent* event(
           const EventMap& events
         ) const noexcept;
 
         /**
-         * @brief Gets this Line's event argument.
+         * @brief Gets the argument of this Line's first Event.
          * @return A string containing the contained event's argument, and "" if that argument doesn't exist.
          */
         [[nodiscard]] const std::string& eventArg() const noexcept;
 
+        /**
+         * @brief Gets the argument of this Line's first Event as parsed by @c link().
+         * @return The parsed argument, which holds an empty string until this Line is linked to an Event.
+         */
+        [[nodiscard]] const EventArgument& argument() const noexcept;
+
         /**
          * @brief Gets this Line's contained text.
          * @return A string of this Line's contained text.
@@ -89,7 +188,7 @@ namespace Scenes
         const std::string _text; //!< The text this line contains.
 
     private:
-        std::optional<std::string> _eventName; //!< An optional that may or may not contain this Line's Event.
-        std::string _eventArg; //!< The event argument _event takes. Is undefined if the Event doesn't exist.
+        EventCalls _events; //!< The Events this Line runs, in order.
+        bool _linked; //!< Whether @c link() has resolved _events.
     };
 } // Scenes
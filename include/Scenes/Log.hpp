@@ -1,18 +1,69 @@
 /**
- * @file Log.cpp
+ * @file Log.hpp
  * @brief Contains the Log class along with relevant types and functions.
  */
 
 #pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include "AppendQueue.hpp"
+#include "LogRecord.hpp"
+
 namespace Scenes
 {
+	class Journal;
+
 	using LogNameType = std::string; //!< The type of key that Log stores.
-	using LogResultType = std::vector<size_t>; //!< The type of result Log stores.
-	using LogType = std::unordered_map<LogNameType, LogResultType>; //!< The type of every record in a Log.
+	using LogResultType = std::vector<size_t>; //!< The type of result Log returns.
+	using LogType = std::unordered_map<LogNameType, LogRecord>; //!< The type of every record in a Log.
+
+    /**
+     * @brief Estimates the heap memory held by a string, which is none for strings short enough to be stored inline.
+     *
+     * @param text The string to measure.
+     * @return The size of the string's heap buffer in bytes.
+     */
+	[[nodiscard]] size_t stringMemoryUsage(
+		const std::string& text
+	) noexcept;
+
+    /**
+     * @brief Holds the flags of everything depending on a record, raising them when the record is appended to.
+     *
+     * Flags are only held weakly, so a dependent stops being notified once its flag is destroyed.
+     */
+	class DependentFlags
+	{
+	public:
+        /**
+         * @brief Adds a flag to raise, dropping flags that were destroyed once the held flags have doubled since they
+         * were last dropped.
+         *
+         * @param flag The flag to set to true.
+         */
+		void add(
+			std::weak_ptr<bool> flag
+		);
+
+        /**
+         * @brief Sets every flag that still exists to true, dropping flags that were destroyed.
+         */
+		void raise() noexcept;
+
+        /**
+         * @brief Gets the number of flags held, including ones destroyed since they were last dropped.
+         */
+		[[nodiscard]] size_t size() const noexcept;
+
+	private:
+		std::vector<std::weak_ptr<bool> > _flags; //!< @internal The flags of every dependent.
+		size_t _pruned = 0; //!< @internal The number of flags held after destroyed flags were last dropped.
+	};
 
     /**
      * @brief Contains a record of key names and a vector of the times they were called.
@@ -22,6 +73,18 @@ namespace Scenes
      * specific record, and find records that contain a substring. As adding to a Log isn't meant to be done manually,
      * no tools are provided to delete added records.
      *
+     * A RetentionPolicy can be set for the whole Log or for single records to bound how many line numbers are kept.
+     * Records that need trimming after a policy change are compacted a few at a time by @c addLog(), or all at once
+     * by @c compact(). The first and last line numbers and the count of a record are always kept, so queries only
+     * reading those are unaffected by retention; queries that need discarded line numbers throw a DiscardedLogError.
+     *
+     * A Log is single-threaded unless it is made concurrent by @c setConcurrent(). A concurrent Log lets any thread
+     * call @c addLog(), which only pushes onto a lock-free queue. The thread owning the Log applies the queued appends
+     * in the order they were made when it calls @c synchronize(), stamping them with the line number at that moment
+     * and starting a new epoch.
+     * Every query made between two calls to @c synchronize() therefore sees the same, consistent Log, without any
+     * lock being taken by appending threads or queries.
+     *
      * @warning Logs and log functions are case-sensitive.
      */
 	class Log
@@ -60,13 +123,138 @@ namespace Scenes
          * @brief Queries this Log for the result vector of a provided record name.
          *
          * @param name The name of the record to query for.
-         * @return A vector containing line numbers of when this record was logged, or an empty vector if the query
-         * fails.
+         * @return A vector containing the kept line numbers of when this record was logged, or an empty vector if the
+         * query fails.
          */
 		[[nodiscard]] virtual LogResultType query(
 			const LogNameType& name
 		) const noexcept;
 
+        /**
+         * @brief Views the result vector of a provided record name without copying it.
+         *
+         * @warning The view is invalidated by the next call to @c addLog().
+         *
+         * @param name The name of the record to view.
+         * @return A view of the kept line numbers of when this record was logged, or an empty view if the query
+         * fails.
+         */
+		[[nodiscard]] LogView view(
+			const LogNameType& name
+		) const noexcept;
+
+        /**
+         * @brief Gets the line number of when a record was first logged.
+         *
+         * @param name The name of the record.
+         * @return The first logged line number, or an empty optional if the record doesn't exist.
+         */
+		[[nodiscard]] std::optional<size_t> first(
+			const LogNameType& name
+		) const noexcept;
+
+        /**
+         * @brief Gets the line number of when a record was last logged.
+         *
+         * @param name The name of the record.
+         * @return The last logged line number, or an empty optional if the record doesn't exist.
+         */
+		[[nodiscard]] std::optional<size_t> last(
+			const LogNameType& name
+		) const noexcept;
+
+        /**
+         * @brief Gets the line number of an occurrence of a record, counting back from the latest one.
+         *
+         * @param name The name of the record.
+         * @param n The number of occurrences to go back past, so 0 gets the same line number as @c last().
+         * @return The line number, or an empty optional if the record doesn't exist or was logged n or fewer times.
+         * @throws DiscardedLogError if the record's RetentionPolicy discarded the occurrence.
+         */
+		[[nodiscard]] std::optional<size_t> nthFromBack(
+			const LogNameType& name,
+			size_t n
+		) const;
+
+        /**
+         * @brief Gets how many times a record has been logged.
+         *
+         * @param name The name of the record.
+         * @return The number of times the record was logged, which is 0 if it doesn't exist.
+         */
+		[[nodiscard]] size_t count(
+			const LogNameType& name
+		) const noexcept;
+
+        /**
+         * @brief Counts how many times a record was logged within an inclusive range of lines.
+         *
+         * Records are logged in line order, so this is a binary search over the record's result vector.
+         *
+         * @param name The name of the record.
+         * @param from The first line of the range.
+         * @param to The last line of the range.
+         * @return The number of times the record was logged in [from, to].
+         * @throws DiscardedLogError if the record's retention policy discarded line numbers in the range.
+         */
+		[[nodiscard]] size_t countBetween(
+			const LogNameType& name,
+			size_t from,
+			size_t to
+		) const;
+
+        /**
+         * @brief Finds the first time a record was logged at or after a given line.
+         *
+         * @param name The name of the record.
+         * @param line The line to search from.
+         * @return The first logged line number >= line, or an empty optional if there is none.
+         * @throws DiscardedLogError if the record's retention policy discarded that line number.
+         */
+		[[nodiscard]] std::optional<size_t> firstAtOrAfter(
+			const LogNameType& name,
+			size_t line
+		) const;
+
+        /**
+         * @brief Sets the retention policy of every record in this Log, including records added later.
+         *
+         * Existing records are trimmed incrementally by later calls to @c addLog() or @c compact().
+         *
+         * @param policy The policy to set.
+         */
+		virtual void setRetention(
+			RetentionPolicy policy
+		);
+
+        /**
+         * @brief Sets the retention policy of a single record, creating the record if it doesn't exist yet.
+         *
+         * @param name The name of the record.
+         * @param policy The policy to set.
+         */
+		void setRetention(
+			const LogNameType& name,
+			RetentionPolicy policy
+		);
+
+        /**
+         * @brief Gets the retention policy given to new records.
+         *
+         * @return The policy of this Log.
+         */
+		[[nodiscard]] const RetentionPolicy& retention() const noexcept;
+
+        /**
+         * @brief Trims records whose retention policy changed.
+         *
+         * @param budget The number of line numbers to discard before stopping.
+         * @return The number of line numbers discarded.
+         */
+		size_t compact(
+			size_t budget = SIZE_MAX
+		);
+
         /**
          * @brief Finds what record names in this Log contain a given search term.
          *
@@ -82,9 +270,170 @@ namespace Scenes
          *
          * @return True if this Log is empty, false otherwise.
          */
-        [[nodiscard]] bool empty() const noexcept;
+        [[nodiscard]] virtual bool empty() const noexcept;
+
+        /**
+         * @brief Estimates the heap and inline memory used by this Log, including its records and dependents.
+         *
+         * @return The size of this Log in bytes.
+         */
+		[[nodiscard]] virtual size_t memoryUsage() const noexcept;
+
+        /**
+         * @brief Lets other threads append to this Log until it is made single-threaded again.
+         *
+         * @warning Must be called by the thread owning this Log while no other thread is appending to it. Turning
+         * concurrency off applies every queued append first.
+         *
+         * @param concurrent Whether @c addLog() may be called from any thread.
+         */
+		void setConcurrent(
+			bool concurrent
+		);
+
+        /**
+         * @brief Checks if @c addLog() may be called from any thread.
+         */
+		[[nodiscard]] bool concurrent() const noexcept;
+
+        /**
+         * @brief Applies the appends queued by other threads, logging them at the current line number.
+         *
+         * Must only be called by the thread owning this Log. Does nothing if this Log isn't concurrent.
+         *
+         * @return The number of appends applied.
+         */
+		size_t synchronize();
+
+        /**
+         * @brief Gets the number of calls to @c synchronize() that applied appends.
+         *
+         * Queries made while the epoch stays the same see the same records.
+         *
+         * @return The current epoch.
+         */
+		[[nodiscard]] std::uint64_t epoch() const noexcept;
+
+        /**
+         * @brief Raises a flag whenever a record is logged to, until the flag is destroyed.
+         *
+         * The record doesn't need to exist yet. Reading a snapshot raises every flag, as any record may have changed.
+         * Flags may be added through a const Log, as they don't change any record.
+         *
+         * @param name The name of the record.
+         * @param flag The flag to set to true.
+         */
+		void addDependent(
+			const LogNameType& name,
+			std::weak_ptr<bool> flag
+		) const;
+
+        /**
+         * @brief Journals every name logged to this Log from now on.
+         *
+         * @param journal The journal to write to, or nullptr to stop journaling. Must outlive its use by this Log.
+         * @param channel Identifies this Log among the Logs sharing journal.
+         */
+		void setJournal(
+			Journal* journal,
+			std::uint8_t channel
+		) noexcept;
+
+        /**
+         * @brief Writes every record and retention policy of this Log to a snapshot.
+         *
+         * @param writer The snapshot to write to.
+         */
+		virtual void writeSnapshot(
+			SnapshotWriter& writer
+		) const;
+
+        /**
+         * @brief Replaces every record and retention policy of this Log with those read from a snapshot.
+         *
+         * @param reader The snapshot to read from.
+         * @throws SnapshotError if the snapshot is truncated or inconsistent.
+         */
+		virtual void readSnapshot(
+			SnapshotReader& reader
+		);
 	protected:
+        /**
+         * @brief Finds the stored record of a name.
+         *
+         * @param name The name of the record.
+         * @return A pointer to the record, or nullptr if the record doesn't exist.
+         */
+		[[nodiscard]] virtual const LogRecord* find(
+			const LogNameType& name
+		) const noexcept;
+
+        /**
+         * @brief Finds the stored record of a name, creating it if it doesn't exist.
+         *
+         * @param name The name of the record.
+         * @return The record.
+         */
+		[[nodiscard]] virtual LogRecord& record(
+			const LogNameType& name
+		);
+
+        /**
+         * @brief Adds to the record of a name, journaling it if a journal is set.
+         *
+         * @param name The name of the record.
+         */
+		void apply(
+			const LogNameType& name
+		) noexcept;
+
+        /**
+         * @brief Raises the flags depending on a record.
+         *
+         * @param name The name of the record.
+         */
+		virtual void raiseDependents(
+			const LogNameType& name
+		) noexcept;
+
+        /**
+         * @brief Applies every queued append.
+         *
+         * @return The number of appends applied.
+         */
+		virtual size_t drainAppends();
+
+        /**
+         * @brief Appends a line to a record, then spends a little time on pending compaction.
+         *
+         * @param record The record to append to.
+         * @param line The line to append, which is raised to the record's last line if it is lower.
+         */
+		void append(
+			LogRecord& record,
+			size_t line
+		) noexcept;
+
+        /**
+         * @brief Queues a record for trimming if its policy allows fewer line numbers than it keeps.
+         *
+         * @param record The record to check.
+         */
+		void scheduleCompaction(
+			LogRecord& record
+		);
+
+		static constexpr size_t compactionStep = 64; //!< Line numbers discarded per @c addLog() call.
+
 		LogType _log; //!< The hash table that stores all records in this Log.
 		const size_t& _linesRead; //!< A reference to the current number of lines that have passed.
+		RetentionPolicy _retention; //!< The retention policy given to new records.
+		std::vector<LogRecord*> _pendingCompaction; //!< Records waiting to be trimmed to their policy.
+		AppendQueue<LogNameType> _queuedNames; //!< Names appended by other threads since the last synchronization.
+		bool _concurrent; //!< Whether other threads may append to this Log.
+		std::uint64_t _epoch; //!< The number of synchronizations that applied appends.
+		Journal* _journal; //!< The journal appends are written to, if any.
+		std::uint8_t _journalChannel; //!< Identifies this Log in _journal.
+		mutable std::unordered_map<LogNameType, DependentFlags> _dependents; //!< The flags depending on each record.
 	};
 } // Scenes
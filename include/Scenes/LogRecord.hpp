@@ -0,0 +1,314 @@
+/**
+ * @file LogRecord.hpp
+ * @brief Contains the LogRecord class along with relevant types and functions.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace Scenes
+{
+	class SnapshotReader;
+	class SnapshotWriter;
+
+    /**
+     * @brief A non-owning view of the line numbers kept by a LogRecord, decoded one at a time as it is iterated.
+     *
+     * @warning A view is invalidated by the next change to its record.
+     */
+	class LogView
+	{
+	public:
+        /**
+         * @brief Walks the kept line numbers in ascending order, decoding each as it is reached.
+         */
+		class Iterator
+		{
+		public:
+			using iterator_concept = std::forward_iterator_tag;
+			using iterator_category = std::input_iterator_tag;
+			using value_type = size_t;
+			using difference_type = std::ptrdiff_t;
+			using reference = size_t;
+
+			Iterator() noexcept;
+
+			[[nodiscard]] size_t operator*() const noexcept;
+			Iterator& operator++() noexcept;
+			Iterator operator++(int) noexcept;
+			[[nodiscard]] bool operator==(const Iterator& rhs) const noexcept;
+
+		private:
+			friend class LogView;
+
+			Iterator(
+				const std::vector<std::uint8_t>* bytes,
+				size_t index,
+				size_t size
+			) noexcept;
+
+			const std::vector<std::uint8_t>* _bytes; //!< @internal The encoded line numbers.
+			size_t _offset; //!< @internal The byte offset just past the current line number.
+			size_t _index; //!< @internal The index of the current line number.
+			size_t _size; //!< @internal The number of line numbers.
+			size_t _line; //!< @internal The current line number.
+		};
+
+		LogView() noexcept;
+
+		[[nodiscard]] Iterator begin() const noexcept;
+		[[nodiscard]] Iterator end() const noexcept;
+		[[nodiscard]] size_t size() const noexcept;
+		[[nodiscard]] bool empty() const noexcept;
+
+        /**
+         * @brief Gets the last kept line number without decoding the others.
+         *
+         * @warning Calling this on an empty view causes undefined behaviour.
+         */
+		[[nodiscard]] size_t back() const noexcept;
+
+	private:
+		friend class LogRecord;
+
+		LogView(
+			const std::vector<std::uint8_t>* bytes,
+			size_t size,
+			size_t back
+		) noexcept;
+
+		const std::vector<std::uint8_t>* _bytes; //!< The encoded line numbers.
+		size_t _size; //!< The number of line numbers.
+		size_t _back; //!< The last line number.
+	};
+
+    /**
+     * @brief Thrown when a query needs line numbers that a RetentionPolicy has discarded.
+     */
+	class DiscardedLogError : public std::runtime_error
+	{
+	public:
+		using std::runtime_error::runtime_error;
+	};
+
+    /**
+     * @brief Decides how many line numbers a LogRecord keeps.
+     *
+     * Every record always knows when it was first and last logged and how many times it was logged, no matter the
+     * policy. The policy only decides how many of the individual line numbers in between are kept.
+     */
+	struct RetentionPolicy
+	{
+		enum class Mode
+		{
+			KeepAll, //!< Keep every line number.
+			KeepLast, //!< Keep at least the latest @c limit line numbers.
+			Summary //!< Keep only the first and last line numbers and the count.
+		};
+
+		Mode mode = Mode::KeepAll; //!< How line numbers are discarded.
+		size_t limit = 0; //!< The number of line numbers kept by Mode::KeepLast.
+
+		[[nodiscard]] static RetentionPolicy keepAll() noexcept;
+		[[nodiscard]] static RetentionPolicy keepLast(size_t limit) noexcept;
+		[[nodiscard]] static RetentionPolicy summary() noexcept;
+
+		void write(SnapshotWriter& writer) const;
+		[[nodiscard]] static RetentionPolicy read(SnapshotReader& reader);
+
+		bool operator==(const RetentionPolicy& rhs) const = default;
+	};
+
+    /**
+     * @brief Stores the line numbers a single Log record was logged at.
+     *
+     * Line numbers are appended in ascending order. A LogRecord trims itself to its RetentionPolicy as it grows, keeping
+     * up to twice the policy limit so that trimming is amortized over many appends. Queries that can be answered
+     * exactly from what is kept are answered; queries that can't throw a DiscardedLogError.
+     *
+     * Kept line numbers are stored as varint-encoded deltas from the previous line number, so most take a single
+     * byte. A skip entry is stored for the start of every block of @c blockSize line numbers, which lets range queries
+     * binary search the blocks and decode only one of them. The first and last line numbers and the count are stored
+     * directly. Line numbers are never kept decoded: @c retained() decodes them one at a time as its view is iterated,
+     * and @c nthFromBack() decodes at most one block.
+     */
+	class LogRecord
+	{
+	public:
+        /**
+         * @brief Initializes a new, empty instance of the LogRecord class.
+         *
+         * @param policy How many line numbers this record keeps.
+         */
+		explicit LogRecord(
+			RetentionPolicy policy = {}
+		) noexcept;
+
+        /**
+         * @brief Records another occurrence at a line number no lower than the last one.
+         *
+         * @param line The line number to record.
+         */
+		void append(
+			size_t line
+		);
+
+        /**
+         * @brief Changes how many line numbers this record keeps.
+         *
+         * Already stored line numbers are only discarded by the next call to @c compact().
+         *
+         * @param policy The new policy.
+         */
+		void setPolicy(
+			RetentionPolicy policy
+		) noexcept;
+
+        /**
+         * @brief Combines the occurrences of another record into this one, then compacts under this record's policy.
+         *
+         * The counts are summed and the first and last line numbers widened to cover both records. Kept line numbers
+         * at or before the later of the two records' discarded line numbers are dropped, since queries there throw.
+         *
+         * @param other The record to merge in.
+         */
+		void merge(
+			const LogRecord& other
+		);
+
+        /**
+         * @brief Discards every line number this record's policy doesn't need to keep.
+         *
+         * @return The number of line numbers discarded.
+         */
+		size_t compact();
+
+        /**
+         * @brief Checks if this record keeps more line numbers than its policy allows.
+         *
+         * @return True if a call to @c compact() would discard line numbers, false otherwise.
+         */
+		[[nodiscard]] bool needsCompaction() const noexcept;
+
+        /**
+         * @brief Views the line numbers this record has kept.
+         *
+         * @return The kept line numbers in ascending order, which are all line numbers if @c complete() is true.
+         */
+		[[nodiscard]] LogView retained() const noexcept;
+
+        /**
+         * @brief Gets an occurrence counting back from the latest one, decoding at most one block.
+         *
+         * @param n The number of occurrences to go back past, so 0 gets the latest.
+         * @return The line number of the occurrence, or an empty optional if this record has n or fewer.
+         * @throws DiscardedLogError if the occurrence was discarded.
+         */
+		[[nodiscard]] std::optional<size_t> nthFromBack(
+			size_t n
+		) const;
+
+        /**
+         * @brief Checks if this record still keeps every line number it was given.
+         *
+         * @return True if no line number has been discarded, false otherwise.
+         */
+		[[nodiscard]] bool complete() const noexcept;
+
+		[[nodiscard]] bool empty() const noexcept;
+		[[nodiscard]] const RetentionPolicy& policy() const noexcept;
+		[[nodiscard]] std::optional<size_t> first() const noexcept;
+		[[nodiscard]] std::optional<size_t> last() const noexcept;
+		[[nodiscard]] size_t count() const noexcept;
+
+        /**
+         * @brief Counts the occurrences within an inclusive range of lines.
+         *
+         * @throws DiscardedLogError if occurrences inside the range may have been discarded.
+         */
+		[[nodiscard]] size_t countBetween(
+			size_t from,
+			size_t to
+		) const;
+
+        /**
+         * @brief Finds the first occurrence at or after a line.
+         *
+         * @throws DiscardedLogError if that occurrence may have been discarded.
+         */
+		[[nodiscard]] std::optional<size_t> firstAtOrAfter(
+			size_t line
+		) const;
+
+        /**
+         * @brief Estimates the heap and inline memory used by this record.
+         *
+         * @return The size of this record in bytes.
+         */
+		[[nodiscard]] size_t memoryUsage() const noexcept;
+
+        /**
+         * @brief Writes this record to a snapshot.
+         *
+         * The encoded line numbers and skip entries are written as they are stored, so reading them back is a copy
+         * rather than a decode.
+         *
+         * @param writer The snapshot to write to.
+         */
+		void write(
+			SnapshotWriter& writer
+		) const;
+
+        /**
+         * @brief Reads a record written by @c write().
+         *
+         * @param reader The snapshot to read from.
+         * @return The read record.
+         * @throws SnapshotError if the snapshot is truncated or inconsistent.
+         */
+		[[nodiscard]] static LogRecord read(
+			SnapshotReader& reader
+		);
+
+		static constexpr size_t blockSize = 32; //!< The number of line numbers between skip entries.
+
+	private:
+        /**
+         * @internal The location of the first line number of a block.
+         */
+		struct SkipEntry
+		{
+			size_t offset; //!< @internal The byte offset just past the encoded line number.
+			size_t line; //!< @internal The decoded line number.
+		};
+
+        /**
+         * @internal The result of searching the kept line numbers.
+         */
+		struct SeekResult
+		{
+			size_t rank; //!< @internal The number of kept line numbers before the searched line.
+			std::optional<size_t> next; //!< @internal The first kept line number not before the searched line.
+		};
+
+		void encode(size_t line);
+		[[nodiscard]] SeekResult seek(size_t line, bool inclusive) const noexcept;
+		[[nodiscard]] size_t retainedTarget() const noexcept;
+
+		std::vector<std::uint8_t> _bytes; //!< The kept line numbers as varint-encoded deltas.
+		std::vector<SkipEntry> _skips; //!< The skip entry of every block in _bytes.
+		size_t _size; //!< The number of kept line numbers.
+		size_t _tail; //!< The last kept line number.
+		size_t _first; //!< The first line number ever appended.
+		size_t _last; //!< The last line number appended.
+		size_t _count; //!< The number of line numbers ever appended.
+		size_t _discardedThrough; //!< The highest line number discarded. Only meaningful if @c complete() is false.
+		RetentionPolicy _policy; //!< How many line numbers are kept.
+	};
+} // Scenes
@@ -0,0 +1,221 @@
+/**
+ * @file Pacing.hpp
+ * @brief Contains the Pacing class and its built-in policies.
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <optional>
+
+#include "Line.hpp"
+
+namespace Scenes
+{
+    /**
+     * @brief Decides when a Reader may read its next Line.
+     *
+     * A Reader checks its Pacing before reading every Line, then tells it about the Line as it starts reading it.
+     * Work done between two Lines, such as running Events, checking Sections or loading a Scene, therefore counts
+     * towards the wait instead of being added to it, and no wait follows the last Line read.
+     *
+     * A Reader stepped from a host's own loop polls @c ready() and never blocks on its Pacing; one reading on a thread
+     * of its own blocks in @c awaitNextLine() instead.
+     *
+     * The built-in policies are FixedPacing, TypewriterPacing, TickedPacing and HeadlessPacing.
+     */
+    class Pacing
+    {
+    public:
+        using Clock = std::chrono::steady_clock; //!< The clock deadlines are measured on.
+
+        virtual ~Pacing() = default;
+
+        /**
+         * @brief Called by the Reader when it starts reading a Line, before printing its text or running its Events.
+         *
+         * @param line The Line being read.
+         */
+        virtual void lineRead(
+            const Line& line
+        ) = 0;
+
+        /**
+         * @brief Checks if the next Line may be read, without waiting.
+         *
+         * @param now The current time.
+         * @return True if the next Line may be read at now, false otherwise.
+         */
+        [[nodiscard]] virtual bool ready(
+            Clock::time_point now
+        ) = 0;
+
+        /**
+         * @brief Gets the earliest time the next Line may be read, so a host knows how long it may sleep.
+         *
+         * @return The time, which may have passed already, or an empty optional if the next Line waits for something
+         * other than time, such as a tick.
+         */
+        [[nodiscard]] virtual std::optional<Clock::time_point> nextDeadline() = 0;
+
+        /**
+         * @brief Returns once the next Line may be read.
+         *
+         * A blocking convenience over @c ready() for Readers reading on a thread of their own. By default it sleeps
+         * until @c nextDeadline(), or polls every millisecond while there is none.
+         */
+        virtual void awaitNextLine();
+    };
+
+    /**
+     * @brief Reads every Line as soon as possible, for automated runs.
+     */
+    class HeadlessPacing final : public Pacing
+    {
+    public:
+        void lineRead(
+            const Line& line
+        ) override;
+
+        [[nodiscard]] bool ready(
+            Clock::time_point now
+        ) override;
+
+        [[nodiscard]] std::optional<Clock::time_point> nextDeadline() override;
+    };
+
+    /**
+     * @brief Holds the next Line back until a deadline set when the previous one was read.
+     *
+     * The first Line is read at once.
+     *
+     * Waiting is done on a condition variable rather than by sleeping, so @c skip() can end a wait from another thread,
+     * such as one handling player input.
+     */
+    class DeadlinePacing : public Pacing
+    {
+    public:
+        [[nodiscard]] bool ready(
+            Clock::time_point now
+        ) override;
+
+        [[nodiscard]] std::optional<Clock::time_point> nextDeadline() override;
+
+        void awaitNextLine() override;
+
+        /**
+         * @brief Lets the next Line be read at once, ending any wait for it.
+         *
+         * May be called from any thread.
+         */
+        void skip();
+
+    protected:
+        /**
+         * @brief Sets when the next Line may be read.
+         *
+         * @param deadline The earliest time the next Line may be read.
+         */
+        void setDeadline(
+            Clock::time_point deadline
+        );
+
+    private:
+        std::mutex _mutex; //!< @internal Guards _deadline.
+        std::condition_variable _skipped; //!< @internal Wakes the Reader when _deadline is moved earlier.
+        Clock::time_point _deadline; //!< @internal The earliest time the next Line may be read.
+    };
+
+    /**
+     * @brief Waits the same time after every Line.
+     */
+    class FixedPacing final : public DeadlinePacing
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the FixedPacing class.
+         *
+         * @param delay The time between reading a Line and reading the next one.
+         */
+        explicit FixedPacing(
+            Clock::duration delay
+        ) noexcept;
+
+        void lineRead(
+            const Line& line
+        ) override;
+
+    private:
+        const Clock::duration _delay; //!< The time between two Lines.
+    };
+
+    /**
+     * @brief Waits as long after every Line as it would take to type its text.
+     */
+    class TypewriterPacing final : public DeadlinePacing
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the TypewriterPacing class.
+         *
+         * @param perCharacter The time taken by every character of a Line's text.
+         * @param minimum The shortest time to wait after a Line, so Lines without text still pause.
+         */
+        explicit TypewriterPacing(
+            Clock::duration perCharacter,
+            Clock::duration minimum = Clock::duration::zero()
+        ) noexcept;
+
+        void lineRead(
+            const Line& line
+        ) override;
+
+    private:
+        const Clock::duration _perCharacter; //!< The time taken by every character.
+        const Clock::duration _minimum; //!< The shortest time to wait after a Line.
+    };
+
+    /**
+     * @brief Lets a Line be read every time it is ticked, for hosts driving the Reader from their own loop.
+     *
+     * Ticks given before the Reader waits are kept, so no tick is lost. Each Line read uses up one tick.
+     */
+    class TickedPacing final : public Pacing
+    {
+    public:
+        void lineRead(
+            const Line& line
+        ) override;
+
+        [[nodiscard]] bool ready(
+            Clock::time_point now
+        ) override;
+
+        [[nodiscard]] std::optional<Clock::time_point> nextDeadline() override;
+
+        void awaitNextLine() override;
+
+        /**
+         * @brief Lets more Lines be read.
+         *
+         * May be called from any thread.
+         *
+         * @param lines The number of Lines to let through.
+         */
+        void tick(
+            size_t lines = 1
+        );
+
+        /**
+         * @brief Gets the number of ticks not used by a Line yet.
+         */
+        [[nodiscard]] size_t pendingTicks();
+
+    private:
+        std::mutex _mutex; //!< @internal Guards _ticks.
+        std::condition_variable _ticked; //!< @internal Wakes the Reader when a tick is given.
+        size_t _ticks = 0; //!< @internal The number of Lines that may be read without waiting.
+    };
+} // Scenes
@@ -1,49 +1,135 @@
 #pragma once
 
+#include <concepts>
+#include <deque>
 #include <filesystem>
 #include <functional>
+#include <future>
+#include <memory>
+#include <optional>
 #include <ostream>
 #include <queue>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <typeindex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 
 #include "Event.hpp"
+#include "EventArgument.hpp"
 #include "EventLog.hpp"
+#include "EventMap.hpp"
+#include "EventPool.hpp"
+#include "EventRegistry.hpp"
+#include "Journal.hpp"
 #include "Log.hpp"
+#include "Pacing.hpp"
+#include "SceneCache.hpp"
 #include "Section.hpp"
 
 namespace Scenes
 {
+    /**
+     * @brief A callable that can be added as an Event by @c Reader::addEvent().
+     *
+     * Event callables take either nothing, the argument text as a std::string, or a single argument of a type that
+     * Line arguments are parsed into.
+     */
+    template<class Function>
+    concept EventCallable = std::invocable<Function&, std::string> || std::invocable<Function&>
+                            || requires { typename ArgumentOf<Function>::type; };
+
+    /**
+     * @brief Describes a Line whose Event name didn't match any added Event when its Scene was loaded.
+     */
+    struct UnresolvedEvent
+    {
+        std::string scene; //!< The Scene containing the Line, or "" if it was restored from a snapshot.
+        std::string eventName; //!< The Event name that wasn't found.
+        std::string lineText; //!< The text of the Line.
+
+        bool operator==(const UnresolvedEvent& rhs) const = default;
+    };
+
     class Reader
     {
 #pragma region Add Events
     private:
+        template<class Function>
         void addCustomEvent(
             const std::string& name,
-            const std::function<int(std::string)>& func
+            Function&& func,
+            ArgumentParser parser = {},
+            EventLogging logging = EventLogging::OnCall
         );
 
-    public:
-
-        void addEvent(
-            const std::string& name,
-            const std::function<int(std::string)>& func
+        template<EventCallable Function>
+        [[nodiscard]] static auto adaptEvent(
+            Function func
         );
 
-        void addEvent(
-            const std::string& name,
-            const std::function<void(std::string)>& func
+        template<EventCallable Function>
+        [[nodiscard]] ArgumentParser parserFor(
+            const std::string& eventName
+        ) const;
+
+        template<class Arg>
+        [[nodiscard]] ArgumentParser argumentParser(
+            const std::string& eventName
+        ) const;
+
+        template<class Function, class ...Args>
+        static int invokeEvent(
+            Function& func,
+            Args&& ...args
         );
 
+    public:
+        /**
+         * @brief Adds an Event that Lines can run by name.
+         *
+         * The callable is stored directly in the Event, without being wrapped in a std::function. If it takes an
+         * argument of a type other than std::string, the argument of every Line running it is parsed into that type
+         * once, when the Line's Scene is loaded, and the Event receives the parsed value. int and double arguments are
+         * parsed with @c parseArgument(), and other types need a parser added by @c addArgumentParser() first.
+         *
+         * @param name The name of the Event.
+         * @param func A callable taking either a single argument or nothing, and returning either an int or nothing.
+         * Events returning nothing log a return value of 0.
+         * @throws std::invalid_argument if func takes an argument type that has no parser, or an Event named name was
+         * already added, including the built-in setNextScene.
+         */
+        template<EventCallable Function>
         void addEvent(
             const std::string& name,
-            const std::function<int(void)>& func
+            Function func
         );
 
+        /**
+         * @brief Adds an Event that runs on a worker thread, so reading continues while it runs.
+         *
+         * A Line running the Event starts the callable on the Reader's EventPool and reading moves on at once. When
+         * the callable returns, its result is logged at the line that ran it. Results are logged in the order their
+         * calls started, while the Reader synchronizes its logs after each Line. Before a Section's Conditions are
+         * checked, the Reader waits for every running call of the Events they query, so which Sections are read never
+         * depends on how long an Event takes. Exceptions thrown by the callable are rethrown by @c read() when the
+         * result is logged.
+         *
+         * @warning The callable may run on several worker threads at once.
+         *
+         * @param name The name of the Event.
+         * @param event The callable, marked by @c asyncEvent(), taking the same arguments as one given to
+         * @c addEvent(const std::string&, Function).
+         * @throws std::invalid_argument if the callable takes an argument type that has no parser, or an Event named
+         * name was already added.
+         */
+        template<EventCallable Function>
         void addEvent(
             const std::string& name,
-            const std::function<void(void)>& func
+            AsyncEvent<Function> event
         );
 
         template<class Ret>
@@ -60,6 +146,9 @@ namespace Scenes
             std::function<int(Ret)> toInt
         );
 
+        /**
+         * @brief Adds an Event whose arguments are parsed by fromString once, when the Scene of a Line is loaded.
+         */
         template<class Arg>
         void addEvent(
             const std::string& name,
@@ -67,6 +156,9 @@ namespace Scenes
             std::function<Arg(std::string)> fromString
         );
 
+        /**
+         * @copydoc addEvent(const std::string&, std::function<int(Arg)>, std::function<Arg(std::string)>)
+         */
         template<class Arg>
         void addEvent(
             const std::string& name,
@@ -74,6 +166,9 @@ namespace Scenes
             std::function<Arg(std::string)> fromString
         );
 
+        /**
+         * @copydoc addEvent(const std::string&, std::function<int(Arg)>, std::function<Arg(std::string)>)
+         */
         template<class Ret, class Arg>
         void addEvent(
             const std::string& name,
@@ -81,12 +176,77 @@ namespace Scenes
             std::function<int(Ret)> toInt,
             std::function<Arg(std::string)> fromString
         );
+
+        /**
+         * @brief Adds how Line arguments of a type are parsed, so that Events taking that type can be added.
+         *
+         * A parser added for int or double replaces the built-in one for Events added afterwards.
+         *
+         * @tparam Arg The parsed type.
+         * @param parser A callable parsing the text of an argument into an Arg, which should throw if it can't.
+         */
+        template<class Arg, class Parser>
+            requires std::is_invocable_r_v<Arg, Parser&, const std::string&>
+        void addArgumentParser(
+            Parser parser
+        );
+
+        /**
+         * @brief Checks if Lines can run an Event by name, whether it was added or is built in.
+         *
+         * @param name The name of the Event.
+         * @return True if an Event named name was added, false otherwise.
+         */
+        [[nodiscard]] bool hasEvent(
+            const std::string& name
+        ) const noexcept;
 #pragma endregion
 
     private:
+        /**
+         * @internal The Lines and Conditions of every Section in a Scene file, before they are made into Sections.
+         */
+        using ParsedScene = std::vector<std::pair<std::vector<Line>, Section::ConditionVector> >;
+
+        [[nodiscard]] std::optional<std::pair<std::filesystem::path, std::filesystem::file_time_type> > findSceneFile(
+            const std::string& sceneName
+        ) const;
         bool loadScene();
+        [[nodiscard]] static std::optional<ParsedScene> readSceneFile(
+            const std::filesystem::path& path
+        );
+        [[nodiscard]] SceneCache::Scene buildScene(
+            ParsedScene parsed
+        );
+        void prefetchNextScenes(
+            const std::vector<Section>& scene
+        );
         bool saveScene();
-        void readSectionIfValid(
+        void linkSection(
+            Section& section,
+            const std::string& sceneName
+        );
+        size_t replayJournal(
+            const std::filesystem::path& path
+        );
+        void synchronizeLogs();
+        void startAsyncEvent(
+            EventId id,
+            EventFunction<int()> call
+        );
+        void logAsyncEvents(
+            const std::vector<EventId>& awaited,
+            bool awaitAll
+        );
+        void awaitAsyncEvents(
+            const Section& section
+        );
+        bool actOnSignals();
+        bool reachNextLine();
+        void readNextLine(
+            std::ostream& stream
+        );
+        void readScenes(
             std::ostream& stream
         );
 
@@ -95,6 +255,206 @@ namespace Scenes
             std::ostream& stream
         );
 
+        /**
+         * @brief Resumes from the save directory, or opens the start Scene, like @c read(), but returns without
+         * reading, leaving the Lines to be read by @c step().
+         *
+         * @throws std::out_of_range if there is nothing to resume from and the start Scene file doesn't exist.
+         */
+        void start();
+
+        /**
+         * @brief Reads the next Line if the pacing lets it be read now, for hosts driving this Reader from their own
+         * loop.
+         *
+         * Never waits on the pacing: if the next Line may not be read yet, only the work leading up to it is done, such
+         * as checking Sections or loading a Scene. Waiting for asynchronous Events the next Line awaits still blocks.
+         * Call @c start() first, then call this until it returns false, sleeping until @c Pacing::nextDeadline() in
+         * between if nothing else needs doing.
+         *
+         * @param stream The output stream Lines are printed to.
+         * @return True if there is more to read, false once reading has finished.
+         */
+        bool step(
+            std::ostream& stream
+        );
+
+        /**
+         * @brief Reads from the start of a Scene until no next Scene is set, without resuming from or saving to the
+         * save directory.
+         *
+         * Nothing read this way is journaled, and Lines logging the stop signal don't save a snapshot until it
+         * returns.
+         *
+         * @param sceneName The name of the Scene file to start from.
+         * @param stream The output stream Lines are printed to.
+         */
+        void readFrom(
+            const std::string& sceneName,
+            std::ostream& stream
+        );
+
+        /**
+         * @brief Calls a function whenever this Reader starts reading the Lines of a Section.
+         *
+         * @param observer Called with the name of the Scene the Section was loaded from, which is "" for Sections
+         * restored from a snapshot, and the index of the Section in that Scene. Replaces any previous observer.
+         */
+        void setSectionObserver(
+            std::function<void(const std::string&, size_t)> observer
+        );
+
+        /**
+         * @brief Gets the log of every Event this Reader has logged.
+         */
+        [[nodiscard]] const EventLog& eventLog() const noexcept;
+
+        /**
+         * @brief Gets the log of every Scene this Reader has loaded.
+         */
+        [[nodiscard]] const Log& sceneLog() const noexcept;
+
+        /**
+         * @brief Estimates the memory used by this Reader and everything it has read, such as its logs and the unread
+         * Sections of its Scene.
+         *
+         * Every Reader reads on its own, so this is what each concurrent playthrough costs a process hosting many.
+         * Events and their captured state aren't counted.
+         *
+         * @return The size of this Reader in bytes.
+         */
+        [[nodiscard]] size_t memoryUsage() const noexcept;
+
+        /**
+         * @brief Gets every Line loaded so far whose Event name didn't match an added Event.
+         *
+         * Lines are linked to their Events once, when their Scene is loaded, so Events should be added before reading.
+         * Unresolved Lines are still read, but run no Event.
+         *
+         * @return The unresolved Lines, in the order they were loaded.
+         */
+        [[nodiscard]] const std::vector<UnresolvedEvent>& unresolvedEvents() const noexcept;
+
+        /**
+         * @brief Sets the size of the EventPool that asynchronous Events run on.
+         *
+         * Waits for every running asynchronous Event and logs its result before replacing the pool.
+         *
+         * @param workers The number of worker threads.
+         * @param capacity The number of calls that may wait for a worker before running another Line blocks.
+         */
+        void setEventWorkers(
+            size_t workers,
+            size_t capacity = 64
+        );
+
+        /**
+         * @brief Gets the number of asynchronous Event calls whose results haven't been logged yet.
+         */
+        [[nodiscard]] size_t pendingEvents() const noexcept;
+
+        /**
+         * @brief Sets the memory the Scenes this Reader keeps parsed may use, dropping the least recently entered ones
+         * until they fit.
+         *
+         * Entering a kept Scene again copies its Sections instead of parsing its file, unless the file was modified
+         * since. A Reader keeps up to 8 MiB of Scenes until this is set.
+         *
+         * @param capacity The memory the kept Scenes may use, in bytes. A capacity of 0 parses every Scene entered.
+         */
+        void setSceneCacheCapacity(
+            size_t capacity
+        );
+
+        /**
+         * @brief Gets the Scenes this Reader keeps parsed, along with how often entering a Scene found it kept.
+         */
+        [[nodiscard]] const SceneCache& sceneCache() const noexcept;
+
+        /**
+         * @brief Sets whether this Reader parses the Scenes that may follow the one it enters on a background thread.
+         *
+         * The Scenes that may follow are those named by the setNextScene Lines of the Scene entered. Only their files
+         * are read and parsed in the background, and entering one waits for its parse to finish rather than starting
+         * over. A Reader prefetches until this is set.
+         *
+         * @param prefetching Whether to parse Scenes ahead. Turning it off drops the Scenes parsed ahead so far.
+         */
+        void setPrefetching(
+            bool prefetching
+        );
+
+        /**
+         * @brief Gets the number of Scenes entered whose file had been parsed ahead.
+         */
+        [[nodiscard]] size_t prefetchedScenes() const noexcept;
+
+        /**
+         * @brief Sets when this Reader may read each Line.
+         *
+         * A Reader waits half a second after every Line until its pacing is set.
+         *
+         * @param pacing The policy to wait on between Lines, or nullptr to read every Line as soon as possible. It is
+         * shared so the caller can keep driving it, such as by ticking a TickedPacing.
+         */
+        void setPacing(
+            std::shared_ptr<Pacing> pacing
+        );
+
+        /**
+         * @brief Lets Events log from other threads while this Reader reads.
+         *
+         * Events run on other threads are logged at the line being read when the Reader next synchronizes its logs,
+         * which it does before checking a Section and after reading each Line.
+         *
+         * @param concurrent Whether Events may log from other threads.
+         */
+        void setConcurrentEvents(
+            bool concurrent
+        );
+
+        /**
+         * @brief Journals every log append and every Line read by the next call to @c read().
+         *
+         * The journal is kept next to the save snapshot and emptied whenever a snapshot is saved. When @c read()
+         * starts, the journal is replayed over the latest snapshot, so a session that ended without saving resumes
+         * from its last committed Line instead of its last save.
+         *
+         * @param options How the journal batches and flushes its writes.
+         */
+        void enableJournal(
+            JournalOptions options = {}
+        );
+
+        /**
+         * @brief Writes the logs, line count, next Scene and unread Sections of this Reader to a binary snapshot.
+         *
+         * @param path The file to write to.
+         * @throws SnapshotError if the file can't be written.
+         */
+        void saveSnapshot(
+            const std::filesystem::path& path
+        ) const;
+
+        /**
+         * @brief Replaces the logs, line count, next Scene and unread Sections of this Reader with a binary snapshot.
+         *
+         * The snapshot is memory-mapped and its log records are copied out as stored, without parsing each entry.
+         *
+         * @param path The snapshot written by @c saveSnapshot().
+         * @throws SnapshotError if the snapshot can't be opened, was written by an incompatible build, or is corrupted.
+         * The logs of this Reader may be partially replaced if the snapshot is corrupted.
+         */
+        void loadSnapshot(
+            const std::filesystem::path& path
+        );
+
+        // Logs, Sections and Events hold references into the Reader, which copying or moving it would leave dangling.
+        Reader(const Reader&) = delete;
+        Reader(Reader&&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+
         Reader(
             std::string sceneLoc,
             std::string saveLoc,
@@ -106,18 +466,262 @@ namespace Scenes
             std::string saveLoc
         );
 
+        /**
+         * @brief Initializes a new instance of the Reader class whose first Events are registered at compile time.
+         *
+         * The registered Events take the indices the registry assigns them, so Lines naming them link to those indices.
+         * Events added with @c addEvent() are placed after them.
+         *
+         * @param registry The Events to register, constructed from their tags.
+         */
+        template<class ...Tags>
+        Reader(
+            EventRegistry<Tags...> registry,
+            std::string sceneLoc,
+            std::string saveLoc,
+            std::string startSceneName = "Opening"
+        );
+
     private:
-        size_t _linesRead; //!< The lines read so far into the game.
-        EventLog _eventLog; //!< A log of recorded events.
-        Log _sceneLog; //!< A log of recorded Scenes.
-        std::deque<Section> _scene; //!< Queue of sections that Reader reads through.
+        Reader(
+            std::string sceneLoc,
+            std::string saveLoc,
+            std::string startSceneName,
+            EventMap (* createEvents)(EventLog&)
+        );
+
+
+        /**
+         * @internal An asynchronous Event call whose result hasn't been logged yet.
+         */
+        struct PendingEvent
+        {
+            EventId id; //!< @internal The interned name of the Event.
+            size_t line; //!< @internal The line that ran the Event, which its result is logged at.
+            std::future<int> result; //!< @internal The result of the call.
+        };
+
+        /**
+         * @internal Everything a single playthrough has read and logged, kept apart from how the Reader is set up.
+         *
+         * Nothing a Reader reads is shared with other Readers, so a process can read any number of playthroughs at
+         * once by giving each its own Reader.
+         */
+        struct Session
+        {
+            Session();
+
+            size_t linesRead; //!< @internal The lines read so far into the game.
+            EventLog eventLog; //!< @internal A log of recorded events.
+            Log sceneLog; //!< @internal A log of recorded Scenes.
+            std::deque<Section> scene; //!< @internal Queue of sections that Reader reads through.
+            std::string nextScene; //!< @internal The name of the next Scene file to read.
+            std::string sceneName; //!< @internal The name of the Scene the Sections in scene were loaded from.
+            size_t sectionIndex; //!< @internal The index of the front of scene in its Scene.
+            size_t lastPauseSignal; //!< @internal The line of the last pause signal acted on.
+            size_t lastStopSignal; //!< @internal The line of the last stop signal acted on.
+            bool reading; //!< @internal Whether a Scene is being read, so more Lines may follow.
+            bool sectionEntered; //!< @internal Whether the front of scene has been checked and its Events awaited.
+            bool sectionStarted; //!< @internal Whether a Line of the front of scene is being or has been read.
+            std::deque<PendingEvent> pendingEvents; //!< @internal Asynchronous Event calls, in the order they started.
+            std::vector<UnresolvedEvent> unresolvedEvents; //!< @internal Lines whose Events weren't found when loaded.
+        };
+
+        Session _session; //!< What this Reader has read so far.
 
         const std::filesystem::path _sceneLoc; //!< The path to the directory of the default Scene files to query.
         std::filesystem::path _saveLoc; //!< The path that Reader can save to.
         const std::string _startScene; //!< The name of the scene that Reader will open first.
-        std::string _nextScene; //!< The name of the next Scene file to read.
 
-        EventMap _events; //!< Map between user-defined Event names to the Events themselves.
+        EventMap _events; //!< The Events that Lines can run, registered ones first.
+        std::unordered_map<std::type_index, ArgumentParser> _argumentParsers; //!< Parsers added for argument types.
+        SceneCache _sceneCache; //!< The Sections of recently entered Scene files, linked to _events.
+
+        /**
+         * @internal A Scene file being parsed ahead of being entered.
+         */
+        struct Prefetch
+        {
+            std::filesystem::file_time_type modified; //!< @internal When the file was modified before parsing.
+            std::future<std::optional<ParsedScene> > scene; //!< @internal The parsed file, if it could be opened.
+        };
+
+        bool _prefetching; //!< Whether Scenes that may follow the one entered are parsed ahead.
+        size_t _prefetchedScenes; //!< The number of Scenes entered whose file had been parsed ahead.
+        std::unordered_map<std::string, Prefetch> _prefetches; //!< The Scene files being parsed ahead, by path.
+        std::unique_ptr<EventPool> _prefetchPool; //!< Parses Scenes ahead. Created by the first Scene to prefetch.
+
+        const EventKey _pauseSignal; //!< The logged Event that pauses reading.
+        const EventKey _stopSignal; //!< The logged Event that stops reading.
+        bool _saving; //!< Whether stop signals save a snapshot.
+
+        std::function<void(const std::string&, size_t)> _sectionObserver; //!< Called as each Section starts.
+
+        std::shared_ptr<Pacing> _pacing; //!< Decides when each Line may be read.
+
+        std::optional<JournalOptions> _journalOptions; //!< How to journal reading, if journaling is enabled.
+        std::unique_ptr<Journal> _journal; //!< The journal of the current read, if journaling is enabled.
+
+        size_t _eventWorkers; //!< The number of worker threads of _eventPool.
+        size_t _eventCapacity; //!< The number of calls that may wait for a worker of _eventPool.
+        std::unique_ptr<EventPool> _eventPool; //!< Runs asynchronous Events. Created by the first one to run.
 
     };
-} // Scenes
\ No newline at end of file
+
+    template<class ...Tags>
+    Reader::Reader(EventRegistry<Tags...>, std::string sceneLoc, std::string saveLoc, std::string startSceneName)
+        : Reader(std::move(sceneLoc), std::move(saveLoc), std::move(startSceneName), [](EventLog& eventLog) {
+            return EventMap(EventRegistry<Tags...>(), eventLog);
+        })
+    {}
+
+#pragma region Add Events
+    template<class Function>
+    void Reader::addCustomEvent(const std::string& name, Function&& func, ArgumentParser parser, EventLogging logging)
+    {
+        if (!_events.emplace(name, std::forward<Function>(func), _session.eventLog, std::move(parser), logging).second)
+            throw std::invalid_argument("Event " + name + " was already added.");
+
+        // Kept Scenes were linked without this Event, so Lines naming it would never run it.
+        _sceneCache.clear();
+    }
+
+    template<class Arg>
+    ArgumentParser Reader::argumentParser(const std::string& eventName) const
+    {
+        if (const auto found = _argumentParsers.find(typeid(Arg)); found != _argumentParsers.end())
+            return found->second;
+
+        if constexpr (std::same_as<Arg, std::string>)
+            return {};
+        else if constexpr (BuiltinArgument<Arg>)
+            return [](const std::string& text) { return EventArgument(parseArgument<Arg>(text)); };
+        else
+            throw std::invalid_argument{ "Event \"" + eventName + "\" takes an argument type with no parser added." };
+    }
+
+    template<class Function, class ...Args>
+    int Reader::invokeEvent(Function& func, Args&& ...args)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<Function&, Args...> >)
+        {
+            std::invoke(func, std::forward<Args>(args)...);
+            return 0;
+        }
+        else
+            return std::invoke(func, std::forward<Args>(args)...);
+    }
+
+    template<EventCallable Function>
+    auto Reader::adaptEvent(Function func)
+    {
+        if constexpr (std::invocable<Function&, const std::string&>)
+            return [func = std::move(func)](const EventArgument& arg) mutable -> int {
+                return invokeEvent(func, arg.get<std::string>());
+            };
+        else if constexpr (std::invocable<Function&, std::string>)
+            return [func = std::move(func)](const EventArgument& arg) mutable -> int {
+                return invokeEvent(func, std::string(arg.get<std::string>()));
+            };
+        else if constexpr (std::invocable<Function&>)
+            return [func = std::move(func)](const EventArgument&) mutable -> int {
+                return invokeEvent(func);
+            };
+        else
+            return [func = std::move(func)](const EventArgument& arg) mutable -> int {
+                return invokeEvent(func, arg.get<typename ArgumentOf<Function>::type>());
+            };
+    }
+
+    template<EventCallable Function>
+    ArgumentParser Reader::parserFor(const std::string& eventName) const
+    {
+        if constexpr (std::invocable<Function&, std::string> || std::invocable<Function&>)
+            return {};
+        else
+            return argumentParser<typename ArgumentOf<Function>::type>(eventName);
+    }
+
+    template<EventCallable Function>
+    void Reader::addEvent(const std::string& name, Function func)
+    {
+        auto parser = parserFor<Function>(name);
+        addCustomEvent(name, adaptEvent(std::move(func)), std::move(parser));
+    }
+
+    template<EventCallable Function>
+    void Reader::addEvent(const std::string& name, AsyncEvent<Function> event)
+    {
+        auto parser = parserFor<Function>(name);
+        const auto id = _session.eventLog.intern(name);
+
+        // Shared with every running call, so calls stay valid even if the Event is moved while they run.
+        auto func = std::make_shared<decltype(adaptEvent(std::move(event.function)))>(
+            adaptEvent(std::move(event.function)));
+        addCustomEvent(name, [this, id, func = std::move(func)](const EventArgument& arg) -> int {
+            startAsyncEvent(id, [func, arg] { return (*func)(arg); });
+            return 0;
+        }, std::move(parser), EventLogging::Deferred);
+    }
+
+    template<class Ret>
+    void Reader::addEvent(const std::string& name, std::function<Ret(std::string)> func, std::function<int(Ret)> toInt)
+    {
+        addCustomEvent(name, [func = std::move(func), toInt = std::move(toInt)](const EventArgument& arg) -> int {
+            return toInt(func(arg.get<std::string>()));
+        });
+    }
+
+    template<class Ret>
+    void Reader::addEvent(const std::string& name, std::function<Ret(void)> func, std::function<int(Ret)> toInt)
+    {
+        addCustomEvent(name, [func = std::move(func), toInt = std::move(toInt)](const EventArgument&) -> int {
+            return toInt(func());
+        });
+    }
+
+    template<class Arg>
+    void Reader::addEvent(const std::string& name, std::function<int(Arg)> func,
+                          std::function<Arg(std::string)> fromString)
+    {
+        addCustomEvent(name, [func = std::move(func)](const EventArgument& arg) -> int {
+            return func(arg.get<std::remove_cvref_t<Arg> >());
+        }, [fromString = std::move(fromString)](const std::string& text) {
+            return EventArgument::make<std::remove_cvref_t<Arg> >(fromString(text));
+        });
+    }
+
+    template<class Arg>
+    void Reader::addEvent(const std::string& name, std::function<void(Arg)> func,
+                          std::function<Arg(std::string)> fromString)
+    {
+        addCustomEvent(name, [func = std::move(func)](const EventArgument& arg) -> int {
+            func(arg.get<std::remove_cvref_t<Arg> >());
+            return 1;
+        }, [fromString = std::move(fromString)](const std::string& text) {
+            return EventArgument::make<std::remove_cvref_t<Arg> >(fromString(text));
+        });
+    }
+
+    template<class Ret, class Arg>
+    void Reader::addEvent(
+        const std::string& name, std::function<Ret(Arg)> func, std::function<int(Ret)> toInt,
+        std::function<Arg(std::string)> fromString)
+    {
+        addCustomEvent(name, [func = std::move(func), toInt = std::move(toInt)](const EventArgument& arg) -> int {
+            return toInt(func(arg.get<std::remove_cvref_t<Arg> >()));
+        }, [fromString = std::move(fromString)](const std::string& text) {
+            return EventArgument::make<std::remove_cvref_t<Arg> >(fromString(text));
+        });
+    }
+
+    template<class Arg, class Parser>
+        requires std::is_invocable_r_v<Arg, Parser&, const std::string&>
+    void Reader::addArgumentParser(Parser parser)
+    {
+        _argumentParsers.insert_or_assign(typeid(Arg), [parser = std::move(parser)](const std::string& text) mutable {
+            return EventArgument::make<Arg>(parser(text));
+        });
+    }
+#pragma endregion
+} // Scenes
@@ -0,0 +1,156 @@
+/**
+ * @file SceneCache.hpp
+ * @brief Contains the SceneCache class along with relevant types and functions.
+ */
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Section.hpp"
+
+namespace Scenes
+{
+    /**
+     * @brief Keeps the Sections of recently loaded Scene files, so entering a Scene again doesn't parse its file.
+     *
+     * Scenes are keyed by the path and modification time of their file, so editing a file replaces its Scene the next
+     * time it is loaded. Once the Scenes held use more memory than the capacity, the least recently used ones are
+     * dropped.
+     *
+     * The Sections held are prototypes to be copied from. Copies share their Lines, so a Scene costs a lookup and a
+     * copy of each Section to enter.
+     */
+    class SceneCache
+    {
+    public:
+        using Scene = std::shared_ptr<const std::vector<Section> >; //!< The Sections of a Scene file, in order.
+
+        /**
+         * @brief Initializes a new instance of the SceneCache class.
+         *
+         * @param capacity The memory the held Scenes may use, in bytes.
+         */
+        explicit SceneCache(
+            size_t capacity = 8 * 1024 * 1024
+        ) noexcept;
+
+        /**
+         * @brief Finds the Scene loaded from a file, counting a hit if it is held and a miss if it isn't.
+         *
+         * A Scene loaded from an older version of the file is dropped, and counts as a miss.
+         *
+         * @param path The path of the Scene file.
+         * @param modified The time the file was last modified.
+         * @return The Scene, or nullptr if it isn't held.
+         */
+        [[nodiscard]] Scene find(
+            const std::filesystem::path& path,
+            std::filesystem::file_time_type modified
+        );
+
+        /**
+         * @brief Checks if the Scene loaded from a file is held, without counting a hit or miss or marking it as used.
+         *
+         * @param path The path of the Scene file.
+         * @param modified The time the file was last modified.
+         * @return True if the Scene loaded from the file when it was last modified is held, false otherwise.
+         */
+        [[nodiscard]] bool contains(
+            const std::filesystem::path& path,
+            std::filesystem::file_time_type modified
+        ) const;
+
+        /**
+         * @brief Holds the Scene loaded from a file as the most recently used one, dropping Scenes until the cache fits
+         * its capacity.
+         *
+         * Scenes larger than the capacity aren't held.
+         *
+         * @param path The path of the Scene file.
+         * @param modified The time the file was last modified when it was loaded.
+         * @param scene The Sections loaded from the file.
+         */
+        void insert(
+            const std::filesystem::path& path,
+            std::filesystem::file_time_type modified,
+            Scene scene
+        );
+
+        /**
+         * @brief Sets the memory the held Scenes may use, dropping the least recently used ones until they fit.
+         *
+         * @param capacity The memory the held Scenes may use, in bytes. A capacity of 0 turns caching off.
+         */
+        void setCapacity(
+            size_t capacity
+        );
+
+        /**
+         * @brief Drops every held Scene, keeping the hit and miss counts.
+         */
+        void clear() noexcept;
+
+        /**
+         * @brief Gets the memory the held Scenes may use, in bytes.
+         */
+        [[nodiscard]] size_t capacity() const noexcept;
+
+        /**
+         * @brief Estimates the memory used by the held Scenes, in bytes.
+         */
+        [[nodiscard]] size_t memoryUsage() const noexcept;
+
+        /**
+         * @brief Gets the number of Scenes held.
+         */
+        [[nodiscard]] size_t size() const noexcept;
+
+        /**
+         * @brief Gets the number of calls to @c find() that found their Scene.
+         */
+        [[nodiscard]] size_t hits() const noexcept;
+
+        /**
+         * @brief Gets the number of calls to @c find() that didn't find their Scene.
+         */
+        [[nodiscard]] size_t misses() const noexcept;
+
+    private:
+        /**
+         * @internal A held Scene and what it was loaded from.
+         */
+        struct Entry
+        {
+            std::string path; //!< @internal The path of the Scene file.
+            std::filesystem::file_time_type modified; //!< @internal When the file was modified before loading.
+            Scene scene; //!< @internal The Sections loaded from the file.
+            size_t memory; //!< @internal The memory used by scene when it was inserted.
+        };
+
+        /**
+         * @internal Drops a held Scene.
+         */
+        void erase(
+            std::list<Entry>::iterator entry
+        ) noexcept;
+
+        /**
+         * @internal Drops the least recently used Scenes until the held ones fit the capacity.
+         */
+        void evict() noexcept;
+
+        size_t _capacity; //!< The memory the held Scenes may use.
+        size_t _memory; //!< The memory used by the held Scenes.
+        size_t _hits; //!< The number of calls to find() that found their Scene.
+        size_t _misses; //!< The number of calls to find() that didn't find their Scene.
+
+        std::list<Entry> _entries; //!< The held Scenes, most recently used first.
+        std::unordered_map<std::string, std::list<Entry>::iterator> _index; //!< Finds held Scenes by path.
+    };
+} // Scenes
@@ -5,9 +5,13 @@
 
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <queue>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -21,8 +25,13 @@ namespace Scenes
      *
      * A Section class is used by Scenes to allow for dynamic script reading and control flow. A Section provides three
      * functions to correctly read its contents. The first two, @c empty() and @c isActive() exist to verify that a
-     * Section is ready for reading, while @c readLine() prints the output of the first single line before removing it
-     * from the Section queue.
+     * Section is ready for reading, while @c readLine() prints the output of the first single line before moving past
+     * it in the Section queue.
+     *
+     * A Section reads its Lines through a cursor rather than removing them, and copies of a Section share the same
+     * Lines, each with its own cursor. Copying a Section or reading it again with @c rewind() therefore never copies
+     * or parses its Lines. Shared Lines are never changed: @c link() gives a Section its own Lines first if they are
+     * shared and still need linking.
      *
      * The Section class does not define any control flow behaviours itself to allow the control flow of Section reading
      * to be defined entirely by the user. A simple Section reading may look like:
@@ -38,11 +47,18 @@ namespace Scenes
     public:
         /**
          * @brief Holds a Section condition's name and the arguments it will take.
+         *
+         * A Condition named "and", "or" or "not" combines the Conditions in its operands instead of taking arguments.
+         * An "and" Condition is true if all of its operands are, an "or" Condition is true if any of them is, and a
+         * "not" Condition takes a single operand and is true if it isn't.
          */
         struct Condition
         {
             std::string name; //!< This Condition's name
             std::vector<std::string> arguments; //!< The arguments taken by this Condition.
+            std::vector<Condition> operands; //!< The Conditions combined by an "and", "or" or "not" Condition.
+
+            Condition() = default;
 
             /**
              * @brief Initializes a new instance of the Condition struct.
@@ -53,158 +69,343 @@ namespace Scenes
                 std::string name,
                 std::vector<std::string> arguments
             );
+
+            /**
+             * @brief Creates a Condition that is true if all of its operands are.
+             * @param operands The Conditions to combine.
+             */
+            [[nodiscard]] static Condition allOf(
+                std::vector<Condition> operands
+            );
+
+            /**
+             * @brief Creates a Condition that is true if any of its operands is.
+             * @param operands The Conditions to combine.
+             */
+            [[nodiscard]] static Condition anyOf(
+                std::vector<Condition> operands
+            );
+
+            /**
+             * @brief Creates a Condition that is true if its operand isn't.
+             * @param operand The Condition to negate.
+             */
+            [[nodiscard]] static Condition negation(
+                Condition operand
+            );
         };
 
         using ConditionVector = std::vector<Condition>;
 
-    private:
-        using UnaryPredicateMap = std::unordered_map<std::string, std::function<bool(const std::string&)> >;
-        using BinaryPredicateMap = std::unordered_map<std::string,
-                                                      std::function<bool(const std::string&, const std::string&)> >;
+        /**
+         * @brief The predicates a Condition can name, each checked by the Section function of the same name.
+         */
+        enum class Predicate : std::uint8_t
+        {
+            ExpectEqual,
+            ExpectLower,
+            ExpectLowerOrEqual,
+            ExpectHigher,
+            ExpectHigherOrEqual,
+            ExpectNotEqual,
+            TriggeredSinceLatestSceneCall,
+            NotTriggeredSinceLatestSceneCall,
+            TriggeredBeforeLatestSceneCall,
+            NotTriggeredBeforeLatestSceneCall,
+            TriggeredBetweenLatestSceneCalls,
+            TriggeredAtLeastSinceLatestSceneCall,
+            TriggeredFewerThanSinceLatestSceneCall,
+            And, //!< Combines the Instructions that follow it, as an "and" Condition.
+            Or, //!< Combines the Instructions that follow it, as an "or" Condition.
+            Not //!< Negates the Instruction that follows it, as a "not" Condition.
+        };
 
         /**
-         * @internal Values used to check Condition results.
+         * @brief Finds the predicate a Condition name refers to.
+         *
+         * Every Section shares one immutable table of predicates, so looking one up never allocates.
+         *
+         * @param name The name of a Condition.
+         * @return The predicate and the number of arguments it takes, or an empty optional if no predicate has that
+         * name.
+         */
+        [[nodiscard]] static std::optional<std::pair<Predicate, size_t> > findPredicate(
+            std::string_view name
+        ) noexcept;
+
+        /**
+         * @brief A Condition compiled for checking, with its arguments parsed and its Event name interned.
+         *
+         * Conditions combining others are compiled into a program listing each Instruction before its operands, so an
+         * Instruction and its operands take up @c length Instructions.
          */
-        enum class CheckResult
+        struct Instruction
         {
-            False,
-            True,
-            InvalidSize, //!< @internal The Condition has too many arguments for its predicate type.
-            InvalidCondition //!< @internal Condition isn't found in a Condition map.
+            Predicate opcode; //!< The predicate that checks this Instruction.
+            EventKey event; //!< The Event record the predicate checks.
+            size_t count; //!< The number of Event records the predicate counts, or 0 if it takes no count.
+            std::string scene; //!< The Scene the predicate checks, or "" if it takes no Scene.
+            size_t length = 1; //!< The number of Instructions making up this one and its operands.
         };
 
+        /**
+         * @brief Compiles a Condition into an Instruction.
+         *
+         * @param condition The Condition to compile.
+         * @param eventLog The eventLog that interns the Condition's Event name.
+         * @return The Instruction checking the same predicate with the same arguments.
+         * @throws std::out_of_range if no predicate has the Condition's name.
+         * @throws std::invalid_argument if the Condition has the wrong number of arguments for its predicate, or if
+         * an argument can't be parsed.
+         */
+        [[nodiscard]] static Instruction compile(
+            const Condition& condition,
+            const EventLog& eventLog
+        );
+
+        /**
+         * @brief Compiles Conditions into a program checking that all of them are true.
+         *
+         * The operands of every "and" and "or" Condition, and the Conditions themselves, are reordered so that the
+         * cheapest predicates are checked first. Checking stops as soon as the result is known.
+         *
+         * @param conditions The Conditions to compile.
+         * @param eventLog The eventLog that interns the Conditions' Event names.
+         * @return The program, which starts with an And Instruction over every compiled Condition.
+         * @throws std::out_of_range or std::invalid_argument if a Condition can't be compiled, as described by
+         * @c compile(). Also throws std::invalid_argument if an "and", "or" or "not" Condition has arguments, if a
+         * "not" Condition doesn't have exactly one operand, or if any other Condition has operands.
+         */
+        [[nodiscard]] static std::vector<Instruction> compileProgram(
+            const ConditionVector& conditions,
+            const EventLog& eventLog
+        );
+
+    private:
+        /**
+         * @internal Appends the Instructions of a Condition and its operands to a program.
+         * @return The estimated cost of checking the appended Instructions.
+         */
+        static size_t compileInto(
+            const Condition& condition,
+            const EventLog& eventLog,
+            std::vector<Instruction>& program
+        );
+
+        /**
+         * @internal Appends an "and", "or" or "not" Instruction followed by its operands to a program.
+         * @return The estimated cost of checking the appended Instructions.
+         */
+        static size_t compileOperator(
+            Predicate opcode,
+            const ConditionVector& operands,
+            const EventLog& eventLog,
+            std::vector<Instruction>& program
+        );
+
 #pragma region Conditions
-        [[nodiscard]] CheckResult checkUnaryCondition(
-            const Condition& condition
-        ) const noexcept;
+        /**
+         * @brief Evaluates an Instruction of this Section's program along with its operands.
+         *
+         * @param index The index of the Instruction in _program.
+         * @return The result of the Instruction.
+         */
+        [[nodiscard]] bool evaluate(
+            size_t index
+        ) const;
 
-        [[nodiscard]] CheckResult checkBinaryCondition(
-            const Condition& condition
-        ) const noexcept;
+        /**
+         * @brief Checks a compiled Condition against the logs of this Section.
+         *
+         * @param instruction The compiled Condition to check.
+         * @return The result of the Condition's predicate.
+         */
+        [[nodiscard]] bool check(
+            const Instruction& instruction
+        ) const;
 
         /**
-         * @brief Check to see if a given eventString has already been logged.
-         * 
-         * @param eventString The eventString to check.
+         * @brief Check to see if a given Event record has already been logged.
+         *
+         * @param key The key of the Event record to check.
          * @return True if one or more logs are found, false otherwise.
          */
         [[nodiscard]] bool expectEqual(
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event has already been logged with a lower result.
-         * 
-         * @param eventString The eventString to check.
+         *
+         * @param key The key of the Event record to check.
          * @return True if one or more logs are found, false otherwise.
          */
         [[nodiscard]] bool expectLower(
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event has already been logged with a lower or equal result.
-         * 
-         * @param eventString The eventString to check.
+         *
+         * @param key The key of the Event record to check.
          * @return True if one or more logs are found, false otherwise.
          */
         [[nodiscard]] bool expectLowerOrEqual(
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event has already been logged with a higher result.
-         * 
-         * @param eventString The eventString to check.
+         *
+         * @param key The key of the Event record to check.
          * @return True if one or more logs are found, false otherwise.
          */
         [[nodiscard]] bool expectHigher(
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event has already been logged with a higher or equal result.
-         * 
-         * @param eventString The eventString to check.
+         *
+         * @param key The key of the Event record to check.
          * @return True if one or more logs are found, false otherwise.
          */
         [[nodiscard]] bool expectHigherOrEqual(
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event hasn't been logged with an equal result.
          *
-         * @param eventString The eventString to check.
+         * @param key The key of the Event record to check.
          * @return True if no logs are found, false otherwise.
          */
         [[nodiscard]] bool expectNotEqual(
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event has been recorded since the latest record of a given Scene.
-         * 
+         *
          * @param sceneName The name of the Scene to check.
-         * @param eventString The eventString to check.
+         * @param key The key of the Event record to check.
          * @return True if the latest Event record >= the latest Scene record, false otherwise.
          * Returns false if the Event or Scene has yet to be recorded, no matter what.
          */
         [[nodiscard]] bool triggeredSinceLatestSceneCall(
             const std::string& sceneName,
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event hasn't been recorded since the latest record of a given Scene.
-         * 
+         *
          * @param sceneName The name of the Scene to check.
-         * @param eventString The eventString to check.
+         * @param key The key of the Event record to check.
          * @return True if the latest Event record < the latest Scene record, false otherwise.
          * Returns true if this Event or Scene has yet to be recorded, no matter what.
          */
         [[nodiscard]] bool notTriggeredSinceLatestSceneCall(
             const std::string& sceneName,
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event has been recorded before the latest record of a given Scene.
-         * 
+         *
          * @param sceneName The name of the Scene to check.
-         * @param eventString The eventString to check.
+         * @param key The key of the Event record to check.
          * @return True if the latest Event record < the latest Scene record, false otherwise.
          * Returns true if the given Scene hasn't been recorded, unless this Event hasn't been recorded either, in
          * which case it returns false.
          */
         [[nodiscard]] bool triggeredBeforeLatestSceneCall(
             const std::string& sceneName,
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
 
         /**
          * @brief Check to see if this Event hasn't been recorded before the latest record of a given Scene.
          *
          * @param sceneName The name of the Scene to check.
-         * @param eventString The eventString to check.
+         * @param key The key of the Event record to check.
          * @return True if the latest Event record >= the latest Scene record, false otherwise.
          * Returns false if the given Scene hasn't been recorded, unless this Event hasn't been recorded either, in
          * which case it returns true.
          */
         [[nodiscard]] bool notTriggeredBeforeLatestSceneCall(
             const std::string& sceneName,
-            const std::string& eventString
-        );
+            const EventKey& key
+        ) const;
+
+        /**
+         * @brief Check to see if this Event was recorded between the two latest records of a given Scene.
+         *
+         * @param sceneName The name of the Scene to check.
+         * @param key The key of the Event record to check.
+         * @return True if the Event was recorded at or after the second latest Scene record and before the latest
+         * one, false otherwise. Returns false if the Scene has been recorded fewer than two times.
+         */
+        [[nodiscard]] bool triggeredBetweenLatestSceneCalls(
+            const std::string& sceneName,
+            const EventKey& key
+        ) const;
+
+        /**
+         * @brief Check to see if this Event has been recorded at least a number of times since the latest record of
+         * a given Scene.
+         *
+         * @param sceneName The name of the Scene to check.
+         * @param key The key of the Event record to check.
+         * @param count The number of Event records required.
+         * @return True if the Event has been recorded count or more times since the latest Scene record, false
+         * otherwise. Returns false if the Scene has yet to be recorded.
+         */
+        [[nodiscard]] bool triggeredAtLeastSinceLatestSceneCall(
+            const std::string& sceneName,
+            const EventKey& key,
+            size_t count
+        ) const;
+
+        /**
+         * @brief Check to see if this Event has been recorded fewer than a number of times since the latest record
+         * of a given Scene.
+         *
+         * @param sceneName The name of the Scene to check.
+         * @param key The key of the Event record to check.
+         * @param count The number of Event records to stay below.
+         * @return True if the Event has been recorded fewer than count times since the latest Scene record, false
+         * otherwise. Returns true if the Scene has yet to be recorded, unless count is 0.
+         */
+        [[nodiscard]] bool triggeredFewerThanSinceLatestSceneCall(
+            const std::string& sceneName,
+            const EventKey& key,
+            size_t count
+        ) const;
 #pragma endregion
 
     public:
         /**
          * @brief Initializes a new instance of the Section class.
          *
-         * @param lines The queue of Lines this Section can read through.
+         * @param lines The Lines this Section can read through, in reading order.
          * @param sceneLogRef A reference to a Log holding currently recorded Scenes.
          * @param eventLogRef A reference to an eventLog.
          * @param conditions The Conditions that need to be true for this Section to be active.
+         * @throws std::out_of_range or std::invalid_argument if a Condition can't be compiled, as described by
+         * @c compile().
+         */
+        Section(
+            std::vector<Line> lines,
+            const Log& sceneLogRef,
+            const EventLog& eventLogRef,
+            ConditionVector conditions
+        );
+
+        /**
+         * @copybrief Section(std::vector<Line>, const Log&, const EventLog&, ConditionVector)
+         *
+         * @copydetails Section(std::vector<Line>, const Log&, const EventLog&, ConditionVector)
          */
         Section(
             std::queue<Line> lines,
@@ -213,6 +414,43 @@ namespace Scenes
             ConditionVector conditions
         );
 
+        /**
+         * @brief Initializes a new instance of the Section class from a snapshot written by @c writeSnapshot().
+         *
+         * @param reader The snapshot to read from.
+         * @param sceneLogRef A reference to a Log holding currently recorded Scenes.
+         * @param eventLogRef A reference to an eventLog.
+         * @throws SnapshotError if the snapshot is truncated or inconsistent.
+         * @throws std::out_of_range or std::invalid_argument if a Condition can't be compiled, as described by
+         * @c compile().
+         */
+        Section(
+            SnapshotReader& reader,
+            const Log& sceneLogRef,
+            const EventLog& eventLogRef
+        );
+
+        /**
+         * @brief Initializes a new instance of the Section class sharing the Lines and holding the Conditions of
+         * another, starting at the same Line.
+         *
+         * @param other The Section to copy.
+         */
+        Section(
+            const Section& other
+        );
+
+        Section(Section&&) noexcept = default;
+
+        /**
+         * @brief Writes the unread Lines, Conditions and checked state of this Section to a snapshot.
+         *
+         * @param writer The snapshot to write to.
+         */
+        void writeSnapshot(
+            SnapshotWriter& writer
+        ) const;
+
         /**
          * @brief Checks if this Section is active or not.
          *
@@ -220,9 +458,11 @@ namespace Scenes
          * queue is empty, and then checks the conditions of this Section. If the queue is empty and all the conditions
          * are true, then the Section is considered active.
          *
-         * @remark As the Conditions tied to this Section are static and decided during this Section's construction,
-         * after the first call to this function, the function will no longer check this Section's conditions, instead
-         * echoing the results of the initial checks. This prevents excess work during repeated calls to this function.
+         * @throws DiscardedLogError if a Condition needs log records discarded by a RetentionPolicy.
+         *
+         * @remark The result of the Conditions is kept between calls. It is only checked again once a record they
+         * query has been logged to, so Events logged while this Section is read still change its state without every
+         * call checking every Condition.
          *
          * @return True if this Section is Active, false otherwise.
          */
@@ -241,6 +481,58 @@ namespace Scenes
             EventMap& events
         ) noexcept;
 
+        /**
+         * @brief Links every Line left in this Section's Line queue to its Event.
+         *
+         * @copydetails Scenes::Line::link(const EventMap&)
+         *
+         * Lines that are already linked aren't linked again, but are still passed to onUnresolved if one of their
+         * Events wasn't found.
+         *
+         * @param events The Event Map to resolve Events in.
+         * @param onUnresolved Called with every Line whose Event name isn't in events, in reading order.
+         * @throws EventArgumentError if the argument of a Line can't be parsed. Lines before it are left linked.
+         */
+        void link(
+            const EventMap& events,
+            const std::function<void(const Line&)>& onUnresolved
+        );
+
+        /**
+         * @brief Gets the names of the Events this Section's Conditions query.
+         *
+         * @return Every Event name appearing in an eventString argument of a Condition, without duplicates, in the
+         * order they are first checked.
+         */
+        [[nodiscard]] std::vector<std::string> eventNames() const;
+
+        /**
+         * @brief Moves past the first Line contained in this Section's Line queue without reading it or running its
+         * Event.
+         *
+         * @warning Skipping from an empty queue causes undefined behaviour.
+         */
+        void skipLine() noexcept;
+
+        /**
+         * @brief Gets the first Line contained in this Section's Line queue, which is the next to be read.
+         *
+         * @warning Getting the Line of an empty queue causes undefined behaviour.
+         */
+        [[nodiscard]] const Line& nextLine() const noexcept;
+
+        /**
+         * @brief Moves this Section's cursor back to its first Line, so every Line can be read again.
+         */
+        void rewind() noexcept;
+
+        /**
+         * @brief Gets every Line of this Section, including the Lines already read.
+         *
+         * @return The Lines, which are shared with every copy of this Section until one of them is linked.
+         */
+        [[nodiscard]] std::shared_ptr<const std::vector<Line> > lines() const noexcept;
+
         /**
          * @brief Checks if this Section's Line queue is empty.
          *
@@ -248,17 +540,35 @@ namespace Scenes
          */
         [[nodiscard]] bool empty() const noexcept;
 
+        /**
+         * @brief Estimates the heap and inline memory used by this Section.
+         *
+         * Lines shared with copies of this Section aren't counted, as they belong to whichever copy outlives the rest.
+         *
+         * @return The size of this Section in bytes.
+         */
+        [[nodiscard]] size_t memoryUsage() const noexcept;
+
     private:
-        std::queue<Line> _lines; //!< The Lines to be read.
+        Section(
+            std::pair<std::vector<Line>, ConditionVector> parts,
+            const Log& sceneLogRef,
+            const EventLog& eventLogRef
+        );
+
+        /**
+         * @internal Has the Logs raise _dirty whenever a record queried by _program is logged to.
+         */
+        void addDependencies() const;
+
+        std::shared_ptr<std::vector<Line> > _lines; //!< The Lines to be read, shared with copies of this Section.
+        size_t _cursor; //!< The index of the next Line to be read.
         const Log& _sceneLogRef; //!< A reference to a log of Scenes.
         const EventLog& _eventLogRef; //!< A reference to a log of Events.
-        const ConditionVector _conditions; //!< The conditions required to activate this Section.
-
-        mutable bool _isChecked; //!< @internal Whether this Section's conditions have already been checked.
-        mutable bool _state; //!< @internal The current activity state of this Section.
-        const UnaryPredicateMap _unaryPredicateMap; //!< @internal Maps between unary condition names to their
-                                                    //!< corresponding predicates.
-        const BinaryPredicateMap _binaryPredicateMap; //!< @internal Maps between binary condition names to their
-                                                      //!< corresponding predicates.
+        ConditionVector _conditions; //!< The conditions required to activate this Section.
+        std::vector<Instruction> _program; //!< _conditions as compiled by @c compileProgram() on construction.
+
+        std::shared_ptr<bool> _dirty; //!< @internal Whether a record queried by _program changed since it was checked.
+        mutable bool _state; //!< @internal The result of _program when it was last checked.
     };
 } // Scenes
@@ -15,5 +15,14 @@ namespace nlohmann
         static void to_json(json& j, Scenes::Line line);
     };
 
-    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(Scenes::Section::Condition, name, arguments);
+    /**
+     * @brief Reads Conditions written as {"name": ..., "arguments": [...]}, or as an expression combining other
+     * Conditions: {"and": [...]}, {"or": [...]} or {"not": {...}}.
+     */
+    template<>
+    struct adl_serializer<Scenes::Section::Condition>
+    {
+        static Scenes::Section::Condition from_json(const json& j);
+        static void to_json(json& j, const Scenes::Section::Condition& condition);
+    };
 }
\ No newline at end of file
@@ -0,0 +1,204 @@
+/**
+ * @file Simulator.hpp
+ * @brief Contains the Simulator class along with relevant types and functions.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Reader.hpp"
+
+namespace Scenes
+{
+    /**
+     * @brief Answers the Events of simulated playthroughs in place of their callables.
+     *
+     * A single Responder answers every session of a simulation, so it is called from several threads at once and
+     * should keep any per-session state out of itself. Randomness should come from the session's random source, so
+     * simulations can be repeated from their seed.
+     */
+    class Responder
+    {
+    public:
+        virtual ~Responder() = default;
+
+        /**
+         * @brief Gets the value a call of an Event returns.
+         *
+         * @param event The name of the Event.
+         * @param argument The argument text of the call.
+         * @param random The random source of the session making the call.
+         * @return The value the Event returns.
+         */
+        [[nodiscard]] virtual int respond(
+            const std::string& event,
+            const std::string& argument,
+            std::mt19937_64& random
+        ) const = 0;
+    };
+
+    /**
+     * @brief Answers every call of an Event with the same value.
+     */
+    class ScriptedResponder final : public Responder
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the ScriptedResponder class.
+         *
+         * @param answers The value returned by each Event.
+         * @param fallback The value returned by Events without an answer.
+         */
+        explicit ScriptedResponder(
+            std::unordered_map<std::string, int> answers,
+            int fallback = 0
+        );
+
+        [[nodiscard]] int respond(
+            const std::string& event,
+            const std::string& argument,
+            std::mt19937_64& random
+        ) const override;
+
+    private:
+        const std::unordered_map<std::string, int> _answers; //!< The value returned by each Event.
+        const int _fallback; //!< The value returned by Events without an answer.
+    };
+
+    /**
+     * @brief Answers every call of an Event with one of its possible values, picked uniformly.
+     */
+    class RandomResponder final : public Responder
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the RandomResponder class.
+         *
+         * @param choices The values each Event may return. Events with no values return fallback's.
+         * @param fallback The values Events without choices may return, which is { 0 } if it is empty.
+         */
+        explicit RandomResponder(
+            std::unordered_map<std::string, std::vector<int> > choices,
+            std::vector<int> fallback = { 0 }
+        );
+
+        [[nodiscard]] int respond(
+            const std::string& event,
+            const std::string& argument,
+            std::mt19937_64& random
+        ) const override;
+
+    private:
+        const std::unordered_map<std::string, std::vector<int> > _choices; //!< The values each Event may return.
+        const std::vector<int> _fallback; //!< The values Events without choices may return.
+    };
+
+    /**
+     * @brief Describes how a Simulator runs its sessions.
+     */
+    struct SimulationOptions
+    {
+        size_t sessions = 1000; //!< The number of playthroughs to run.
+        size_t workers = 0; //!< The number of threads running sessions, or 0 for one per hardware thread.
+        size_t lineLimit = 100000; //!< The Lines a session may read before it is stopped as a likely loop.
+        std::uint64_t seed = 0; //!< Seeds the random source of every session, so a simulation can be repeated.
+
+        /**
+         * @brief Adds Events to the Reader of every session before the Responder answers the rest.
+         *
+         * Events added here keep their own behaviour, and aren't counted in @c SimulationReport::eventReturns.
+         */
+        std::function<void(Reader&)> setup;
+    };
+
+    /**
+     * @brief The coverage of every session of a simulation, added together.
+     */
+    struct SimulationReport
+    {
+        size_t sessions = 0; //!< The number of sessions run.
+        size_t finished = 0; //!< The sessions that read until no next Scene was set.
+        size_t stopped = 0; //!< The sessions stopped by @c SimulationOptions::lineLimit.
+        size_t failed = 0; //!< The sessions that threw an exception.
+
+        std::map<std::string, size_t> scenes; //!< The number of sessions loading each Scene file.
+        std::map<std::pair<std::string, size_t>, size_t> sections; //!< The number of sessions reading each Section.
+        std::map<std::string, std::map<int, size_t> > eventReturns; //!< How often each Event returned each value.
+        std::map<std::string, size_t> endings; //!< The number of finished sessions whose last Section was in a Scene.
+
+        std::vector<std::string> unvisitedScenes; //!< The Scene files no session loaded.
+        std::vector<std::pair<std::string, size_t> > unreadSections; //!< The Sections no session read a Line of.
+    };
+
+    /**
+     * @brief Runs many headless playthroughs of a script in parallel to measure how much of it can be reached.
+     *
+     * Every session reads from the start Scene with its own Reader, which reads Lines as fast as possible and never
+     * saves. Every Event named by a Line of a Scene file is answered by a Responder, except Events the Reader adds
+     * itself, such as setNextScene, and Events added by @c SimulationOptions::setup.
+     *
+     * Sessions are spread over worker threads that each take sessions from their own queue and steal from the others
+     * once it is empty, so long sessions don't leave other workers idle.
+     *
+     * Sections are identified by the name of their Scene file and their index in it.
+     */
+    class Simulator
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the Simulator class, reading every Scene file in sceneLoc.
+         *
+         * @param sceneLoc The directory holding the Scene files.
+         * @param startScene The name of the Scene file every session starts from.
+         * @param responder Answers the Events of every session.
+         * @throws nlohmann::json::exception if a Scene file isn't valid.
+         */
+        Simulator(
+            std::filesystem::path sceneLoc,
+            std::string startScene,
+            std::shared_ptr<const Responder> responder
+        );
+
+        /**
+         * @brief Runs every session and adds their coverage together.
+         *
+         * @param options How to run the sessions.
+         * @return The coverage of every session.
+         */
+        [[nodiscard]] SimulationReport run(
+            const SimulationOptions& options = {}
+        ) const;
+
+        /**
+         * @brief Gets the name of every Event a Line of a Scene file runs, in alphabetical order.
+         */
+        [[nodiscard]] const std::vector<std::string>& eventNames() const noexcept;
+
+    private:
+        /**
+         * @internal Runs a single session, adding its coverage to a report.
+         */
+        void runSession(
+            size_t index,
+            const SimulationOptions& options,
+            SimulationReport& report
+        ) const;
+
+        const std::filesystem::path _sceneLoc; //!< The directory holding the Scene files.
+        const std::string _startScene; //!< The name of the Scene file every session starts from.
+        const std::shared_ptr<const Responder> _responder; //!< Answers the Events of every session.
+
+        std::map<std::string, size_t> _sceneSections; //!< The number of Sections in each Scene file.
+        std::vector<std::string> _eventNames; //!< Every Event a Line of a Scene file runs.
+    };
+} // Scenes
@@ -0,0 +1,239 @@
+/**
+ * @file Snapshot.hpp
+ * @brief Contains the binary snapshot reader and writer along with relevant types and functions.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Scenes
+{
+    /**
+     * @brief Thrown when a snapshot can't be written, opened or understood.
+     */
+    class SnapshotError : public std::runtime_error
+    {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+    constexpr std::uint32_t snapshotMagic = 0x534E4353; //!< "SCNS" in little-endian order.
+    constexpr std::uint32_t snapshotVersion = 3; //!< The snapshot layout written by this build.
+
+    /**
+     * @brief Builds a binary snapshot in memory.
+     *
+     * Values are written in native byte order; the header written by @c writeHeader() records the byte order so
+     * that a snapshot from a different platform is rejected rather than misread.
+     */
+    class SnapshotWriter
+    {
+    public:
+        /**
+         * @brief Writes the magic number, version and byte order of a snapshot.
+         */
+        void writeHeader();
+
+        /**
+         * @brief Writes a trivially copyable value.
+         *
+         * @param value The value to write.
+         */
+        template<class T> requires std::is_trivially_copyable_v<T>
+        void write(
+            const T& value
+        );
+
+        /**
+         * @brief Writes a length-prefixed string.
+         *
+         * @param value The string to write.
+         */
+        void writeString(
+            const std::string& value
+        );
+
+        /**
+         * @brief Writes a length-prefixed array of trivially copyable values in one copy.
+         *
+         * @param values The values to write.
+         */
+        template<class T> requires std::is_trivially_copyable_v<T>
+        void writeArray(
+            std::span<const T> values
+        );
+
+        /**
+         * @brief Writes the snapshot to a file, replacing it if it exists.
+         *
+         * The snapshot is written and flushed to disk beside the file before it is renamed over it, so the file holds
+         * either the old snapshot or the new one even if the process crashes while saving.
+         *
+         * @param path The file to write to.
+         * @throws SnapshotError if the file can't be written.
+         */
+        void saveTo(
+            const std::filesystem::path& path
+        ) const;
+
+        [[nodiscard]] const std::vector<char>& data() const noexcept;
+
+    private:
+        /**
+         * @brief Writes the snapshot to a file and flushes it to disk.
+         *
+         * @param path The file to write to.
+         * @return True if the whole snapshot reached the disk, false otherwise.
+         */
+        [[nodiscard]] bool writeFile(
+            const std::filesystem::path& path
+        ) const noexcept;
+
+        std::vector<char> _data; //!< The snapshot written so far.
+    };
+
+    /**
+     * @brief Reads a binary snapshot from memory, usually a MappedFile.
+     *
+     * Every read is bounds checked, so truncated or corrupted snapshots throw a SnapshotError instead of reading past
+     * the end of the data.
+     */
+    class SnapshotReader
+    {
+    public:
+        /**
+         * @brief Initializes a new instance of the SnapshotReader class.
+         *
+         * @param data The snapshot to read. Must outlive this reader.
+         */
+        explicit SnapshotReader(
+            std::span<const char> data
+        ) noexcept;
+
+        /**
+         * @brief Reads and checks the magic number, version and byte order of a snapshot.
+         *
+         * @throws SnapshotError if the header doesn't match this build.
+         */
+        void readHeader();
+
+        /**
+         * @brief Reads a trivially copyable value.
+         */
+        template<class T> requires std::is_trivially_copyable_v<T>
+        [[nodiscard]] T read();
+
+        /**
+         * @brief Reads a length-prefixed string.
+         */
+        [[nodiscard]] std::string readString();
+
+        /**
+         * @brief Reads a length-prefixed array of trivially copyable values in one copy.
+         *
+         * @param values The vector to replace with the read values.
+         */
+        template<class T> requires std::is_trivially_copyable_v<T>
+        void readArray(
+            std::vector<T>& values
+        );
+
+        /**
+         * @brief Checks if every byte of the snapshot has been read.
+         */
+        [[nodiscard]] bool atEnd() const noexcept;
+
+    private:
+        /**
+         * @brief Consumes bytes from the snapshot.
+         *
+         * @param size The number of bytes to consume.
+         * @return A pointer to the first consumed byte.
+         * @throws SnapshotError if fewer than size bytes are left.
+         */
+        const char* take(
+            size_t size
+        );
+
+        std::span<const char> _data; //!< The snapshot being read.
+        size_t _offset; //!< The number of bytes read so far.
+    };
+
+    /**
+     * @brief Maps a file read-only into memory for the lifetime of the object.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Maps a file into memory.
+         *
+         * @param path The file to map.
+         * @throws SnapshotError if the file can't be opened or mapped.
+         */
+        explicit MappedFile(
+            const std::filesystem::path& path
+        );
+
+        ~MappedFile();
+
+        /**
+         * @brief Gets the mapped contents of the file.
+         */
+        [[nodiscard]] std::span<const char> data() const noexcept;
+
+    private:
+        void release() noexcept;
+
+        const char* _data; //!< The start of the mapping.
+        size_t _size; //!< The size of the mapping.
+#ifdef _WIN32
+        void* _file; //!< The handle of the mapped file.
+        void* _mapping; //!< The handle of the file mapping.
+#endif
+    };
+
+    template<class T> requires std::is_trivially_copyable_v<T>
+    void SnapshotWriter::write(const T& value)
+    {
+        const auto bytes = reinterpret_cast<const char*>(&value);
+        _data.insert(_data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<class T> requires std::is_trivially_copyable_v<T>
+    void SnapshotWriter::writeArray(std::span<const T> values)
+    {
+        write<std::uint64_t>(values.size());
+        const auto bytes = reinterpret_cast<const char*>(values.data());
+        _data.insert(_data.end(), bytes, bytes + values.size_bytes());
+    }
+
+    template<class T> requires std::is_trivially_copyable_v<T>
+    T SnapshotReader::read()
+    {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    template<class T> requires std::is_trivially_copyable_v<T>
+    void SnapshotReader::readArray(std::vector<T>& values)
+    {
+        const auto size = read<std::uint64_t>();
+        if (size > (_data.size() - _offset) / sizeof(T))
+            throw SnapshotError{ "Snapshot is truncated." };
+
+        values.resize(size);
+        std::memcpy(values.data(), take(size * sizeof(T)), size * sizeof(T));
+    }
+} // Scenes
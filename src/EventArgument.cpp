@@ -0,0 +1,67 @@
+#include "EventArgument.hpp"
+
+#include <charconv>
+
+#include "pch.h"
+
+namespace Scenes
+{
+    namespace
+    {
+        template<class T>
+        T parseNumber(const std::string& text, const char* typeName)
+        {
+            const char* first = text.data();
+            const char* last = text.data() + text.size();
+
+            T value;
+            const auto [end, error] = std::from_chars(first, last, value);
+            if (error != std::errc() || end != last || first == last)
+                throw EventArgumentError{ "\"" + text + "\" isn't a valid " + typeName + "." };
+
+            return value;
+        }
+    }
+
+    EventArgument::EventArgument() noexcept
+        : _value(std::string())
+    {}
+
+    EventArgument::EventArgument(std::string text) noexcept
+        : _value(std::move(text))
+    {}
+
+    EventArgument::EventArgument(const char* text)
+        : _value(std::string(text))
+    {}
+
+    EventArgument::EventArgument(int value) noexcept
+        : _value(value)
+    {}
+
+    EventArgument::EventArgument(double value) noexcept
+        : _value(value)
+    {}
+
+    EventArgument::EventArgument(Custom custom) noexcept
+        : _value(std::move(custom))
+    {}
+
+    template<>
+    int parseArgument<int>(const std::string& text)
+    {
+        return parseNumber<int>(text, "int");
+    }
+
+    template<>
+    double parseArgument<double>(const std::string& text)
+    {
+        return parseNumber<double>(text, "double");
+    }
+
+    template<>
+    std::string parseArgument<std::string>(const std::string& text)
+    {
+        return text;
+    }
+} // Scenes
@@ -1,13 +1,336 @@
 #include "EventLog.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <functional>
+#include <iterator>
+#include <tuple>
+
+#include "Journal.hpp"
+#include "Snapshot.hpp"
 #include "pch.h"
 
 namespace Scenes
 {
+	size_t EventKeyHash::operator()(const EventKey& key) const noexcept
+	{
+		const auto packed = (static_cast<std::uint64_t>(key.id) << 32) | static_cast<std::uint32_t>(key.returnValue);
+		return std::hash<std::uint64_t>{}(packed);
+	}
+
+	std::optional<std::pair<std::string, int> > splitEventString(const std::string& eventString) noexcept
+	{
+		const auto cutoff = eventString.find(',');
+		if (cutoff == std::string::npos)
+			return {};
+
+		const char* first = eventString.data() + cutoff + 1;
+		const char* last = eventString.data() + eventString.size();
+
+		int returnValue;
+		const auto [end, error] = std::from_chars(first, last, returnValue);
+
+		// Only accept the exact text createEventString() writes, so that ", 10" or ",010" keep their own records.
+		if (error != std::errc() || end != last || first == last || (*first == '0' && last - first > 1)
+			|| (*first == '-' && (last - first == 1 || first[1] == '0')))
+			return {};
+
+		return std::make_optional<std::pair<std::string, int> >(eventString.substr(0, cutoff), returnValue);
+	}
+
 	EventLog::EventLog(const size_t& linesRead) noexcept
 		: Log(linesRead)
 	{}
 
+	EventId EventLog::intern(const std::string& eventName) const
+	{
+		const auto [it, inserted] = _ids.try_emplace(eventName, static_cast<EventId>(_names.size()));
+		if (inserted)
+			_names.push_back(eventName);
+
+		return it->second;
+	}
+
+	std::optional<EventId> EventLog::findId(const std::string& eventName) const noexcept
+	{
+		const auto it = _ids.find(eventName);
+
+		if (it == _ids.end())
+			return {};
+		return it->second;
+	}
+
+	const std::string& EventLog::eventName(EventId id) const noexcept
+	{
+		return _names[id];
+	}
+
+	std::optional<EventKey> EventLog::findKey(const std::string& eventString) const noexcept
+	{
+		const auto split = splitEventString(eventString);
+		if (!split)
+			return {};
+
+		const auto id = findId(split->first);
+		if (!id)
+			return {};
+		return EventKey{ *id, split->second };
+	}
+
+	void EventLog::addLog(const LogNameType& name) noexcept
+	{
+		if (_concurrent)
+			_queuedAppends.push(name);
+		else
+			Log::apply(name);
+	}
+
+	void EventLog::addLog(const EventKey& key) noexcept
+	{
+		if (_concurrent)
+			_queuedAppends.push(key);
+		else
+			apply(key, _linesRead);
+	}
+
+	void EventLog::addLog(const EventKey& key, size_t line) noexcept
+	{
+		apply(key, line);
+	}
+
+	void EventLog::addLogs(std::span<const EventKey> keys) noexcept
+	{
+		if (_concurrent)
+		{
+			for (const auto& key : keys)
+				_queuedAppends.push(key);
+			return;
+		}
+
+		// Every key is logged at the same line, so grouping equal keys changes nothing but the order they're journaled.
+		std::vector<EventKey> sorted(keys.begin(), keys.end());
+		std::ranges::sort(sorted, [](const EventKey& lhs, const EventKey& rhs)
+		{
+			return std::tie(lhs.id, lhs.returnValue) < std::tie(rhs.id, rhs.returnValue);
+		});
+
+		for (auto key = sorted.begin(); key != sorted.end();)
+		{
+			auto& result = record(*key);
+			const auto sameKey = std::find_if(key, sorted.end(), [&](const EventKey& other) { return other != *key; });
+			for (; key != sameKey; ++key)
+			{
+				append(result, _linesRead);
+				if (_journal)
+					_journal->logEvent(_linesRead, *key, _names[key->id]);
+			}
+
+			// Dependents watch every return value of an Event, so they are raised once its last key is appended.
+			const auto id = std::prev(key)->id;
+			if ((key == sorted.end() || key->id != id) && id < _eventDependents.size())
+				_eventDependents[id].raise();
+		}
+	}
+
+
+	void EventLog::addDependent(EventId id, std::weak_ptr<bool> flag) const
+	{
+		if (_eventDependents.size() <= id)
+			_eventDependents.resize(id + 1);
+		_eventDependents[id].add(std::move(flag));
+	}
+
+	LogResultType EventLog::query(const EventKey& key) const noexcept
+	{
+		const auto result = view(key);
+		return { result.begin(), result.end() };
+	}
+
+	LogView EventLog::view(const EventKey& key) const noexcept
+	{
+		const auto result = find(key);
+
+		if (!result)
+			return {};
+		return result->retained();
+	}
+
+	std::optional<size_t> EventLog::first(const EventKey& key) const noexcept
+	{
+		const auto result = find(key);
+
+		if (!result)
+			return {};
+		return result->first();
+	}
+
+	std::optional<size_t> EventLog::last(const EventKey& key) const noexcept
+	{
+		const auto result = find(key);
+
+		if (!result)
+			return {};
+		return result->last();
+	}
+
+	size_t EventLog::count(const EventKey& key) const noexcept
+	{
+		const auto result = find(key);
+		return result ? result->count() : 0;
+	}
+
+	size_t EventLog::countBetween(const EventKey& key, size_t from, size_t to) const
+	{
+		const auto result = find(key);
+		return result ? result->countBetween(from, to) : 0;
+	}
+
+	std::optional<size_t> EventLog::firstAtOrAfter(const EventKey& key, size_t line) const
+	{
+		const auto result = find(key);
+
+		if (!result)
+			return {};
+		return result->firstAtOrAfter(line);
+	}
+
+	void EventLog::setRetention(RetentionPolicy policy)
+	{
+		Log::setRetention(policy);
+		_eventRetention.clear();
+
+		for (auto& result : _events | std::views::values)
+		{
+			result.setPolicy(policy);
+			scheduleCompaction(result);
+		}
+	}
+
+	void EventLog::setRetention(EventId id, RetentionPolicy policy)
+	{
+		_eventRetention.insert_or_assign(id, policy);
+
+		for (const int returnValue : returnValues(id))
+		{
+			auto& result = _events.at({ id, returnValue });
+			result.setPolicy(policy);
+			scheduleCompaction(result);
+		}
+	}
+
+	const LogRecord* EventLog::find(const LogNameType& name) const noexcept
+	{
+		if (splitEventString(name))
+		{
+			const auto key = findKey(name);
+			return key ? find(*key) : nullptr;
+		}
+
+		return Log::find(name);
+	}
+
+	LogRecord& EventLog::record(const LogNameType& name)
+	{
+		if (const auto split = splitEventString(name))
+			return record(EventKey{ intern(split->first), split->second });
+
+		return Log::record(name);
+	}
+
+	void EventLog::raiseDependents(const LogNameType& name) noexcept
+	{
+		const auto split = splitEventString(name);
+		if (!split)
+		{
+			Log::raiseDependents(name);
+			return;
+		}
+
+		if (const auto id = findId(split->first); id && *id < _eventDependents.size())
+			_eventDependents[*id].raise();
+	}
+
+	void EventLog::apply(const EventKey& key, size_t line) noexcept
+	{
+		append(record(key), line);
+		if (key.id < _eventDependents.size())
+			_eventDependents[key.id].raise();
+
+		if (_journal)
+			_journal->logEvent(line, key, _names[key.id]);
+	}
+
+	size_t EventLog::drainAppends()
+	{
+		// Names and keys share a queue, so appends made in one epoch are applied and journaled in the order made.
+		return Log::drainAppends() + _queuedAppends.drain([this](const std::variant<LogNameType, EventKey>& append)
+		{
+			if (const auto key = std::get_if<EventKey>(&append))
+				apply(*key, _linesRead);
+			else
+				Log::apply(std::get<LogNameType>(append));
+		});
+	}
+
+	const LogRecord* EventLog::find(const EventKey& key) const noexcept
+	{
+		const auto it = _events.find(key);
+
+		if (it == _events.end())
+			return nullptr;
+		return &it->second;
+	}
+
+	LogRecord& EventLog::record(const EventKey& key)
+	{
+		const auto retention = _eventRetention.find(key.id);
+		const auto [it, inserted] = _events.try_emplace(
+			key, retention == _eventRetention.end() ? _retention : retention->second
+		);
+
+		if (inserted)
+		{
+			if (_returns.size() <= key.id)
+				_returns.resize(key.id + 1);
+			_returns[key.id].insert(key.returnValue);
+		}
+
+		return it->second;
+	}
+
+	const std::set<int>& EventLog::returnValues(EventId id) const noexcept
+	{
+		static const std::set<int> none;
+		return id < _returns.size() ? _returns[id] : none;
+	}
+
+	std::optional<int> EventLog::lowestReturn(const std::string& eventName) const noexcept
+	{
+		const auto id = findId(eventName);
+		if (!id || returnValues(*id).empty())
+			return {};
+		return *returnValues(*id).begin();
+	}
+
+	std::optional<int> EventLog::highestReturn(const std::string& eventName) const noexcept
+	{
+		const auto id = findId(eventName);
+		if (!id || returnValues(*id).empty())
+			return {};
+		return *returnValues(*id).rbegin();
+	}
+
+	bool EventLog::anyReturnBetween(const std::string& eventName, int min, int max) const noexcept
+	{
+		const auto id = findId(eventName);
+		if (!id)
+			return false;
+
+		const auto& values = returnValues(*id);
+		const auto it = values.lower_bound(min);
+		return it != values.end() && *it <= max;
+	}
+
 	/// <returns>
 	///		A vector of eventStrings in the form "name, result" given the name.
 	///		If none are found, returns an empty vector.
@@ -16,10 +339,153 @@ namespace Scenes
 	{
 		std::vector<LogNameType> results;
 
+		if (const auto id = findId(eventName))
+			for (const int returnValue : returnValues(*id))
+				results.push_back(_names[*id] + "," + std::to_string(returnValue));
+
 		for (const auto& key : _log | std::views::keys)
 			if (const auto cutoff = key.find(','); key.substr(0, cutoff) == eventName)
 				results.push_back(key);
 
 		return results;
 	}
+
+	bool EventLog::empty() const noexcept
+	{
+		return _events.empty() && Log::empty();
+	}
+
+	size_t EventLog::memoryUsage() const noexcept
+	{
+		// A std::set node holds its value beside a color, a parent and two children.
+		constexpr size_t setNodeOverhead = 4 * sizeof(void*);
+
+		size_t usage = Log::memoryUsage() - sizeof(Log) + sizeof(EventLog)
+			+ (_events.bucket_count() + _ids.bucket_count()) * sizeof(void*)
+			+ _names.capacity() * sizeof(std::string) + _returns.capacity() * sizeof(std::set<int>)
+			+ _eventDependents.capacity() * sizeof(DependentFlags);
+		for (const auto& record : _events | std::views::values)
+			usage += sizeof(void*) + sizeof(EventKey) + record.memoryUsage();
+		for (const auto& name : _names)
+			usage += sizeof(void*) + sizeof(std::string) + sizeof(EventId) + 2 * stringMemoryUsage(name);
+		for (const auto& values : _returns)
+			usage += values.size() * (setNodeOverhead + sizeof(int));
+		for (const auto& flags : _eventDependents)
+			usage += flags.size() * sizeof(std::weak_ptr<bool>);
+
+		return usage;
+	}
+
+	void EventLog::writeSnapshot(SnapshotWriter& writer) const
+	{
+		Log::writeSnapshot(writer);
+
+		writer.write<std::uint64_t>(_names.size());
+		for (const auto& name : _names)
+			writer.writeString(name);
+
+		writer.write<std::uint64_t>(_eventRetention.size());
+		for (const auto& [id, policy] : _eventRetention)
+		{
+			writer.write(id);
+			policy.write(writer);
+		}
+
+		writer.write<std::uint64_t>(_events.size());
+		for (const auto& [key, result] : _events)
+		{
+			writer.write(key.id);
+			writer.write(key.returnValue);
+			result.write(writer);
+		}
+	}
+
+	void EventLog::readSnapshot(SnapshotReader& reader)
+	{
+		Log::readSnapshot(reader);
+		_events.clear();
+		_returns.clear();
+		_eventRetention.clear();
+
+		// Map the ids of the snapshot onto the ids of this EventLog.
+		std::vector<EventId> ids(reader.read<std::uint64_t>());
+		for (auto& id : ids)
+			id = intern(reader.readString());
+
+		const auto remap = [&ids](EventId id)
+		{
+			if (id >= ids.size())
+				throw SnapshotError{ "Snapshot contains an unknown Event id." };
+			return ids[id];
+		};
+
+		const auto retentionSize = reader.read<std::uint64_t>();
+		for (std::uint64_t i = 0; i < retentionSize; i++)
+		{
+			const auto id = remap(reader.read<EventId>());
+			_eventRetention.insert_or_assign(id, RetentionPolicy::read(reader));
+		}
+
+		const auto eventsSize = reader.read<std::uint64_t>();
+		for (std::uint64_t i = 0; i < eventsSize; i++)
+		{
+			const auto id = remap(reader.read<EventId>());
+			const EventKey key{ id, reader.read<int>() };
+
+			auto& result = record(key);
+			result = LogRecord::read(reader);
+			scheduleCompaction(result);
+		}
+		adoptNamedRecords();
+
+		for (auto& flags : _eventDependents)
+			flags.raise();
+	}
+
+	void EventLog::adoptNamedRecords()
+	{
+		for (auto it = _log.begin(); it != _log.end();)
+		{
+			const auto split = splitEventString(it->first);
+			if (!split)
+			{
+				++it;
+				continue;
+			}
+
+			auto named = std::move(it->second);
+			std::erase(_pendingCompaction, &it->second);
+			it = _log.erase(it);
+
+			const EventKey key{ intern(split->first), split->second };
+			auto& result = record(key);
+			if (result.empty())
+				result = std::move(named);
+			else
+				result.merge(named);
+			scheduleCompaction(result);
+		}
+	}
+
+	EventBatch::~EventBatch()
+	{
+		commit();
+	}
+
+	void EventBatch::add(EventLog& eventLog, const EventKey& key)
+	{
+		if (_eventLog != &eventLog)
+		{
+			commit();
+			_eventLog = &eventLog;
+		}
+		_keys.push_back(key);
+	}
+
+	void EventBatch::commit() noexcept
+	{
+		if (_eventLog)
+			_eventLog->addLogs(_keys);
+		_keys.clear();
+	}
 } // Scenes
@@ -0,0 +1,57 @@
+#include "EventMap.hpp"
+
+#include <stdexcept>
+
+#include "pch.h"
+
+namespace Scenes
+{
+    std::optional<EventIndex> EventMap::find(const std::string& name) const noexcept
+    {
+        const auto found = _indices.find(name);
+        if (found == _indices.end())
+            return {};
+
+        return found->second;
+    }
+
+    LineEvent& EventMap::at(const std::string& name)
+    {
+        return _events[_indices.at(name)];
+    }
+
+    const LineEvent& EventMap::at(const std::string& name) const
+    {
+        return _events[_indices.at(name)];
+    }
+
+    LineEvent& EventMap::operator[](EventIndex index) noexcept
+    {
+        return _events[index];
+    }
+
+    const LineEvent& EventMap::operator[](EventIndex index) const noexcept
+    {
+        return _events[index];
+    }
+
+    EventArgument EventMap::parse(EventIndex index, const std::string& text) const
+    {
+        return _parsers[index] ? _parsers[index](text) : EventArgument(text);
+    }
+
+    bool EventMap::contains(const std::string& name) const noexcept
+    {
+        return _indices.contains(name);
+    }
+
+    size_t EventMap::size() const noexcept
+    {
+        return _events.size();
+    }
+
+    bool EventMap::empty() const noexcept
+    {
+        return _events.empty();
+    }
+} // Scenes
@@ -0,0 +1,82 @@
+#include "EventPool.hpp"
+
+#include <algorithm>
+
+#include "pch.h"
+
+namespace Scenes
+{
+    EventPool::EventPool(size_t workers, size_t capacity)
+        : _capacity(std::max<size_t>(capacity, 1)), _stopping(false)
+    {
+        workers = std::max<size_t>(workers, 1);
+        _threads.reserve(workers);
+        try
+        {
+            for (size_t i = 0; i < workers; i++)
+                _threads.emplace_back(&EventPool::workLoop, this);
+        } catch (...)
+        {
+            stop();
+            throw;
+        }
+    }
+
+    EventPool::~EventPool()
+    {
+        stop();
+    }
+
+    void EventPool::submit(EventFunction<void()> task)
+    {
+        {
+            std::unique_lock lock(_mutex);
+            _spaceReady.wait(lock, [this] { return _tasks.size() < _capacity; });
+            _tasks.push_back(std::move(task));
+        }
+        _taskReady.notify_one();
+    }
+
+    size_t EventPool::workers() const noexcept
+    {
+        return _threads.size();
+    }
+
+    void EventPool::stop() noexcept
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _taskReady.notify_all();
+
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    void EventPool::workLoop() noexcept
+    {
+        while (true)
+        {
+            EventFunction<void()> task;
+            {
+                std::unique_lock lock(_mutex);
+                _taskReady.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+
+                // Keep working through the queue when stopping, so every submitted task still runs.
+                if (_tasks.empty())
+                    return;
+
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+            _spaceReady.notify_one();
+
+            try
+            {
+                task();
+            } catch (...)
+            {}
+        }
+    }
+} // Scenes
@@ -0,0 +1,448 @@
+#include "Journal.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Snapshot.hpp"
+#include "pch.h"
+
+namespace Scenes
+{
+    namespace
+    {
+        constexpr std::uint8_t defineRecord = 0xFF; //!< Names an Event id. Never handed to replay handlers.
+        constexpr size_t frameHeaderSize = 2 * sizeof(std::uint32_t); //!< The size and checksum of a commit.
+
+        void writeVarint(std::vector<std::uint8_t>& bytes, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            bytes.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        void writeDelta(std::vector<std::uint8_t>& bytes, size_t& previous, size_t line)
+        {
+            // Zigzag-encode the delta, so line numbers that go backwards, like after loading a save, still fit.
+            const auto delta = static_cast<std::int64_t>(line - previous);
+            writeVarint(bytes, (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63));
+            previous = line;
+        }
+
+        void writeName(std::vector<std::uint8_t>& bytes, const std::string& name)
+        {
+            writeVarint(bytes, name.size());
+            bytes.insert(bytes.end(), name.begin(), name.end());
+        }
+
+        std::uint32_t checksum(const std::uint8_t* bytes, size_t size) noexcept
+        {
+            // FNV-1a, which is enough to catch torn and partially written commits.
+            std::uint32_t hash = 2166136261u;
+            for (size_t i = 0; i < size; i++)
+                hash = (hash ^ bytes[i]) * 16777619u;
+            return hash;
+        }
+
+        /**
+         * @internal Reads the records of a single commit, throwing if one is cut short.
+         */
+        class CommitReader
+        {
+        public:
+            explicit CommitReader(std::span<const std::uint8_t> bytes) noexcept
+                : _bytes(bytes), _offset(0)
+            {}
+
+            [[nodiscard]] bool atEnd() const noexcept
+            {
+                return _offset == _bytes.size();
+            }
+
+            std::uint8_t readByte()
+            {
+                if (atEnd())
+                    throw JournalError{ "Journal contains a malformed record." };
+                return _bytes[_offset++];
+            }
+
+            std::uint64_t readVarint()
+            {
+                std::uint64_t value = 0;
+                for (int shift = 0; shift < 64; shift += 7)
+                {
+                    const auto byte = readByte();
+                    value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                    if (!(byte & 0x80))
+                        return value;
+                }
+                throw JournalError{ "Journal contains a malformed record." };
+            }
+
+            size_t readDelta(size_t& previous)
+            {
+                const auto zigzag = readVarint();
+                const auto delta = static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+                previous += static_cast<size_t>(delta);
+                return previous;
+            }
+
+            std::string_view readName()
+            {
+                const auto size = readVarint();
+                if (size > _bytes.size() - _offset)
+                    throw JournalError{ "Journal contains a malformed record." };
+
+                const std::string_view name{ reinterpret_cast<const char*>(_bytes.data() + _offset), size };
+                _offset += size;
+                return name;
+            }
+
+        private:
+            std::span<const std::uint8_t> _bytes;
+            size_t _offset;
+        };
+    }
+
+    Journal::Journal(const std::filesystem::path& path, JournalOptions options)
+        : _options(options), _pendingLine(0), _appended(0), _written(0), _synced(0), _syncRequested(false),
+          _stopping(false), _failed(false), _generation(0)
+    {
+#ifdef _WIN32
+        _file = _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        _file = open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+#endif
+        if (_file < 0)
+            throw JournalError{ "Unable to open journal " + path.string() + "." };
+
+        // Appends land at the end of the file, so a torn commit left by a crash would hide them from replay.
+        try
+        {
+            const auto end = replay(path, [](const JournalEntry&) {});
+#ifdef _WIN32
+            const bool truncated = _chsize_s(_file, static_cast<long long>(end)) == 0;
+#else
+            const bool truncated = ftruncate(_file, static_cast<off_t>(end)) == 0;
+#endif
+            if (!truncated)
+                throw JournalError{ "Unable to recover journal " + path.string() + "." };
+        } catch (JournalError&)
+        {
+#ifdef _WIN32
+            _close(_file);
+#else
+            close(_file);
+#endif
+            throw;
+        }
+
+        _thread = std::thread(&Journal::commitLoop, this);
+    }
+
+    Journal::~Journal()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_one();
+        _thread.join();
+
+#ifdef _WIN32
+        _close(_file);
+#else
+        close(_file);
+#endif
+    }
+
+    template<class Encode>
+    void Journal::append(Encode&& encode) noexcept
+    {
+        try
+        {
+            {
+                std::lock_guard lock(_mutex);
+                encode(_pending);
+                _appended++;
+            }
+            _wake.notify_one();
+        } catch (...)
+        {
+            std::lock_guard lock(_mutex);
+            _failed = true;
+        }
+    }
+
+    void Journal::logName(std::uint8_t channel, size_t line, const std::string& name) noexcept
+    {
+        append([&](std::vector<std::uint8_t>& bytes)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(JournalEntry::Kind::Name));
+            bytes.push_back(channel);
+            writeDelta(bytes, _pendingLine, line);
+            writeName(bytes, name);
+        });
+    }
+
+    void Journal::logEvent(size_t line, const EventKey& key, const std::string& name) noexcept
+    {
+        append([&](std::vector<std::uint8_t>& bytes)
+        {
+            if (_defined.size() <= key.id)
+                _defined.resize(key.id + 1);
+            if (!_defined[key.id])
+            {
+                bytes.push_back(defineRecord);
+                writeVarint(bytes, key.id);
+                writeName(bytes, name);
+                _defined[key.id] = true;
+            }
+
+            const auto returnValue = static_cast<std::int64_t>(key.returnValue);
+            bytes.push_back(static_cast<std::uint8_t>(JournalEntry::Kind::Event));
+            writeDelta(bytes, _pendingLine, line);
+            writeVarint(bytes, key.id);
+            writeVarint(bytes, (static_cast<std::uint64_t>(returnValue) << 1) ^ static_cast<std::uint64_t>(returnValue >> 63));
+        });
+    }
+
+    void Journal::logProgress(JournalEntry::Kind kind, size_t line) noexcept
+    {
+        append([&](std::vector<std::uint8_t>& bytes)
+        {
+            bytes.push_back(static_cast<std::uint8_t>(kind));
+            writeDelta(bytes, _pendingLine, line);
+        });
+    }
+
+    void Journal::flush()
+    {
+        std::unique_lock lock(_mutex);
+        const auto target = _appended;
+        _syncRequested = true;
+        _wake.notify_one();
+
+        _committed.wait(lock, [&] { return _synced >= target; });
+        if (_failed)
+            throw JournalError{ "Unable to write to journal." };
+    }
+
+    void Journal::clear()
+    {
+        flush();
+
+        // Records appended while clearing belong to the records being cleared.
+        std::scoped_lock lock(_fileMutex, _mutex);
+#ifdef _WIN32
+        const bool truncated = _chsize_s(_file, 0) == 0;
+#else
+        const bool truncated = ftruncate(_file, 0) == 0;
+#endif
+        if (!truncated)
+            throw JournalError{ "Unable to clear journal." };
+
+        _pending.clear();
+        _pendingLine = 0;
+        _defined.clear();
+        _generation++;
+        _written = _synced = _appended;
+    }
+
+    size_t Journal::replay(const std::filesystem::path& path,
+                           const std::function<void(const JournalEntry&)>& handler)
+    {
+        if (!std::filesystem::exists(path))
+            return 0;
+
+        std::optional<MappedFile> file;
+        try
+        {
+            file.emplace(path);
+        } catch (SnapshotError&)
+        {
+            throw JournalError{ "Unable to read journal " + path.string() + "." };
+        }
+
+        const auto data = file->data();
+        const std::span<const std::uint8_t> bytes{ reinterpret_cast<const std::uint8_t*>(data.data()), data.size() };
+        std::vector<std::string_view> names;
+        size_t end = 0;
+
+        for (size_t offset = 0; bytes.size() - offset >= frameHeaderSize; end = offset)
+        {
+            std::uint32_t size, sum;
+            std::memcpy(&size, bytes.data() + offset, sizeof(size));
+            std::memcpy(&sum, bytes.data() + offset + sizeof(size), sizeof(sum));
+            offset += frameHeaderSize;
+
+            // Stop at the first commit that was cut short or corrupted by a crash.
+            if (size > bytes.size() - offset || checksum(bytes.data() + offset, size) != sum)
+                break;
+
+            CommitReader reader{ bytes.subspan(offset, size) };
+            offset += size;
+
+            size_t line = 0;
+            while (!reader.atEnd())
+            {
+                const auto kind = reader.readByte();
+                if (kind == defineRecord)
+                {
+                    const auto id = reader.readVarint();
+                    if (id > UINT32_MAX)
+                        throw JournalError{ "Journal contains a malformed record." };
+                    if (names.size() <= id)
+                        names.resize(id + 1);
+                    names[id] = reader.readName();
+                    continue;
+                }
+
+                JournalEntry entry{ static_cast<JournalEntry::Kind>(kind), 0, 0, {}, {} };
+                switch (entry.kind)
+                {
+                    case JournalEntry::Kind::Name:
+                        entry.channel = reader.readByte();
+                        entry.line = reader.readDelta(line);
+                        entry.name = reader.readName();
+                        break;
+                    case JournalEntry::Kind::Event:
+                    {
+                        entry.line = reader.readDelta(line);
+                        const auto id = reader.readVarint();
+                        const auto zigzag = reader.readVarint();
+                        if (id >= names.size() || names[id].data() == nullptr)
+                            throw JournalError{ "Journal logs an Event before naming it." };
+
+                        entry.key = { static_cast<EventId>(id),
+                                      static_cast<int>(static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1)) };
+                        entry.name = names[id];
+                        break;
+                    }
+                    case JournalEntry::Kind::Line:
+                    case JournalEntry::Kind::SectionEnd:
+                        entry.line = reader.readDelta(line);
+                        break;
+                    default:
+                        throw JournalError{ "Journal contains an unknown record." };
+                }
+
+                handler(entry);
+            }
+        }
+
+        return end;
+    }
+
+    void Journal::commitLoop()
+    {
+        using Clock = std::chrono::steady_clock;
+
+        std::unique_lock lock(_mutex);
+        auto lastSync = Clock::now();
+        const auto ready = [this] { return _stopping || _syncRequested || !_pending.empty(); };
+
+        while (true)
+        {
+            if (_options.sync == JournalSync::Periodic && _written > _synced)
+                _wake.wait_until(lock, lastSync + _options.syncInterval, ready);
+            else
+                _wake.wait(lock, ready);
+
+            // Group commit: give other appends a moment to join this batch, unless someone is waiting on it.
+            if (!_pending.empty() && !_stopping && !_syncRequested && _options.commitDelay.count() > 0)
+                _wake.wait_for(lock, _options.commitDelay, [this] { return _stopping || _syncRequested; });
+
+            std::vector<std::uint8_t> batch;
+            batch.swap(_pending);
+            _pendingLine = 0;
+
+            const auto target = _appended;
+            const auto generation = _generation;
+            const auto now = Clock::now();
+            const bool sync = _syncRequested || _stopping || _options.sync == JournalSync::EveryCommit
+                || (_options.sync == JournalSync::Periodic && now - lastSync >= _options.syncInterval);
+            const bool stopping = _stopping;
+            _syncRequested = false;
+            lock.unlock();
+
+            bool failed = false;
+            try
+            {
+                // A batch taken before a clear() names Events the cleared file did, so it is dropped with them.
+                std::lock_guard fileLock(_fileMutex);
+                if (!batch.empty() && generation == _generation)
+                    writeFile(batch);
+                if (sync)
+                    syncFile();
+            } catch (JournalError&)
+            {
+                failed = true;
+            }
+
+            lock.lock();
+            _failed = _failed || failed;
+            _written = std::max(_written, target);
+            if (sync)
+            {
+                _synced = std::max(_synced, target);
+                lastSync = now;
+            }
+            _committed.notify_all();
+
+            if (stopping && _pending.empty())
+                return;
+        }
+    }
+
+    void Journal::writeFile(const std::vector<std::uint8_t>& bytes)
+    {
+        if (bytes.size() > UINT32_MAX)
+            throw JournalError{ "Journal commit is too large." };
+
+        std::vector<std::uint8_t> frame(frameHeaderSize);
+        const auto size = static_cast<std::uint32_t>(bytes.size());
+        const auto sum = checksum(bytes.data(), bytes.size());
+        std::memcpy(frame.data(), &size, sizeof(size));
+        std::memcpy(frame.data() + sizeof(size), &sum, sizeof(sum));
+        frame.insert(frame.end(), bytes.begin(), bytes.end());
+
+        for (size_t offset = 0; offset < frame.size();)
+        {
+#ifdef _WIN32
+            const auto written = _write(_file, frame.data() + offset, static_cast<unsigned>(frame.size() - offset));
+#else
+            const auto written = write(_file, frame.data() + offset, frame.size() - offset);
+#endif
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                throw JournalError{ "Unable to write to journal." };
+            offset += static_cast<size_t>(written);
+        }
+    }
+
+    void Journal::syncFile()
+    {
+#ifdef _WIN32
+        const bool synced = _commit(_file) == 0;
+#else
+        const bool synced = fsync(_file) == 0;
+#endif
+        if (!synced)
+            throw JournalError{ "Unable to flush journal." };
+    }
+} // Scenes
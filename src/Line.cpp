@@ -1,5 +1,9 @@
 #include "Line.hpp"
 
+#include <exception>
+#include <tuple>
+#include <utility>
+
 #include "pch.h"
 
 #include "Event.hpp"
@@ -7,51 +11,138 @@
 namespace Scenes
 {
 
+    EventCall::EventCall(std::string name, std::string arg)
+        : name(std::move(name)), arg(std::move(arg)), argument(), index(EventMap::noEvent)
+    {}
+
+    bool EventCall::operator==(const EventCall& rhs) const
+    {
+        return name == rhs.name && arg == rhs.arg;
+    }
+
     Line::Line(std::string text, std::string eventName, std::string eventArg = "")
-        : _text(std::move(text)), _eventName(std::make_optional<std::string>(std::move(eventName))),
-          _eventArg(std::move(eventArg))
+        : _text(std::move(text)), _events({ EventCall(std::move(eventName), std::move(eventArg)) }), _linked(false)
+    {}
+
+    Line::Line(std::string text, EventCalls events)
+        : _text(std::move(text)), _events(std::move(events)), _linked(false)
     {}
 
     Line::Line(std::string text)
-        : _text(std::move(text))
+        : _text(std::move(text)), _linked(false)
     {}
 
-    void Line::readLine(std::ostream& stream, EventMap& events)
+    void Line::readLine(std::ostream& stream, EventMap& events) const
     {
         stream << _text;
-        if (_eventName.has_value())
+
+        EventBatch batch;
+        for (const auto& call : _events)
+        {
+            if (_linked)
+            {
+                // noEvent is past the end of any Event Map, so one comparison covers Events that weren't found.
+                if (call.index < events.size())
+                    events[call.index](batch, call.argument);
+            }
+            else if (const auto index = events.find(call.name))
+            {
+                // Malformed arguments are reported by link(), so reading an unlinked Line treats them like a missing
+                // Event.
+                std::optional<EventArgument> argument;
+                try
+                {
+                    argument = events.parse(*index, call.arg);
+                } catch (const std::exception&)
+                {
+                    continue;
+                }
+                events[*index](batch, *argument);
+            }
+        }
+    }
+
+    bool Line::link(const EventMap& events)
+    {
+        // Parse every argument before changing any call, so a malformed one leaves this Line unlinked.
+        InlineVector<std::pair<EventIndex, EventArgument>, 1> resolved;
+        resolved.reserve(_events.size());
+        for (const auto& call : _events)
+        {
+            const auto index = events.find(call.name).value_or(EventMap::noEvent);
+            if (index == EventMap::noEvent)
+            {
+                resolved.emplace_back(index, EventArgument());
+                continue;
+            }
+
             try
             {
-                (events.at(_eventName.value()))(_eventArg);
-            } catch (std::out_of_range&) {}
+                resolved.emplace_back(index, events.parse(index, call.arg));
+            } catch (const std::exception& e)
+            {
+                throw EventArgumentError{ "Argument \"" + call.arg + "\" of Event \"" + call.name + "\" in Line \""
+                                          + _text + "\" can't be parsed: " + e.what() };
+            }
+        }
+
+        bool found = true;
+        for (size_t i = 0; i < _events.size(); i++)
+        {
+            std::tie(_events[i].index, _events[i].argument) = std::move(resolved[i]);
+            found = found && _events[i].index != EventMap::noEvent;
+        }
+        _linked = true;
+
+        return found;
     }
 
-    const std::optional<std::string>& Line::eventName() const noexcept
+    bool Line::linked() const noexcept
     {
-        return _eventName;
+        return _linked;
     }
 
+    const EventCalls& Line::events() const noexcept
+    {
+        return _events;
+    }
 
+    EventIndex Line::eventId() const noexcept
+    {
+        return _linked && !_events.empty() ? _events[0].index : EventMap::noEvent;
+    }
+
+    std::optional<std::string> Line::eventName() const
+    {
+        if (_events.empty())
+            return {};
+
+        return _events[0].name;
+    }
 
     const std::string& Line::text() const noexcept
     {
         return _text;
     }
 
-    std::optional<Event<std::string>> Line::event(const EventMap& events) const noexcept
+    LineEvent* Line::event(EventMap& events) const noexcept
     {
-        if (!_eventName)
-            return {};
+        return const_cast<LineEvent*>(event(std::as_const(events)));
+    }
+
+    const LineEvent* Line::event(const EventMap& events) const noexcept
+    {
+        if (_events.empty())
+            return nullptr;
 
-        auto event =  events.find(_eventName.value());
-        return event == events.end() ? std::optional<Event<std::string> >() : std::make_optional(event->second);
+        const auto index = events.find(_events[0].name);
+        return index ? &events[*index] : nullptr;
     }
 
     bool Line::operator==(const Line& rhs) const
     {
         return _text == rhs._text &&
-               _eventName == rhs._eventName &&
-               _eventArg == rhs._eventArg;
+               _events == rhs._events;
     }
 
     bool Line::operator!=(const Line& rhs) const
@@ -61,6 +152,13 @@ namespace Scenes
 
     const std::string& Line::eventArg() const noexcept
     {
-        return _eventArg;
+        static const std::string noArg;
+        return _events.empty() ? noArg : _events[0].arg;
+    }
+
+    const EventArgument& Line::argument() const noexcept
+    {
+        static const EventArgument noArgument;
+        return _events.empty() ? noArgument : _events[0].argument;
     }
 } // Scenes
\ No newline at end of file
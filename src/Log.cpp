@@ -1,26 +1,158 @@
 #include "Log.hpp"
 
+#include <algorithm>
+
+#include "Journal.hpp"
+#include "Snapshot.hpp"
 #include "pch.h"
 
 
 namespace Scenes
 {
+	size_t stringMemoryUsage(const std::string& text) noexcept
+	{
+		return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+	}
+
+	void DependentFlags::add(std::weak_ptr<bool> flag)
+	{
+		_flags.push_back(std::move(flag));
+
+		// Only prune once the flags have doubled since the last prune, so each add costs O(1) amortized.
+		if (_flags.size() >= 2 * std::max<size_t>(_pruned, 1))
+		{
+			std::erase_if(_flags, [](const auto& held) { return held.expired(); });
+			_pruned = _flags.size();
+		}
+	}
+
+	void DependentFlags::raise() noexcept
+	{
+		std::erase_if(_flags, [](const auto& held)
+		{
+			const auto flag = held.lock();
+			if (flag)
+				*flag = true;
+			return !flag;
+		});
+		_pruned = _flags.size();
+	}
+
+	size_t DependentFlags::size() const noexcept
+	{
+		return _flags.size();
+	}
+
 	Log::Log(const size_t& linesRead) noexcept
-		: _log(LogType()), _linesRead(linesRead)
+		: _log(LogType()), _linesRead(linesRead), _concurrent(false), _epoch(0), _journal(nullptr),
+		  _journalChannel(0)
 	{}
 
 	void Log::addLog(const LogNameType& name) noexcept
 	{
-		_log[name].push_back(_linesRead);
+		if (_concurrent)
+			_queuedNames.push(name);
+		else
+			apply(name);
 	}
 
 	LogResultType Log::query(const LogNameType& name) const noexcept
 	{
-		const auto it = _log.find(name);
+		const auto result = view(name);
+		return { result.begin(), result.end() };
+	}
 
-		if (it == _log.end())
+	LogView Log::view(const LogNameType& name) const noexcept
+	{
+		const auto result = find(name);
+
+		if (!result)
+			return {};
+		return result->retained();
+	}
+
+	std::optional<size_t> Log::first(const LogNameType& name) const noexcept
+	{
+		const auto result = find(name);
+
+		if (!result)
+			return {};
+		return result->first();
+	}
+
+	std::optional<size_t> Log::last(const LogNameType& name) const noexcept
+	{
+		const auto result = find(name);
+
+		if (!result)
+			return {};
+		return result->last();
+	}
+
+	std::optional<size_t> Log::nthFromBack(const LogNameType& name, size_t n) const
+	{
+		const auto result = find(name);
+
+		if (!result)
+			return {};
+		return result->nthFromBack(n);
+	}
+
+	size_t Log::count(const LogNameType& name) const noexcept
+	{
+		const auto result = find(name);
+		return result ? result->count() : 0;
+	}
+
+	size_t Log::countBetween(const LogNameType& name, size_t from, size_t to) const
+	{
+		const auto result = find(name);
+		return result ? result->countBetween(from, to) : 0;
+	}
+
+	std::optional<size_t> Log::firstAtOrAfter(const LogNameType& name, size_t line) const
+	{
+		const auto result = find(name);
+
+		if (!result)
 			return {};
-		return it->second;
+		return result->firstAtOrAfter(line);
+	}
+
+	void Log::setRetention(RetentionPolicy policy)
+	{
+		_retention = policy;
+
+		for (auto& result : _log | std::views::values)
+		{
+			result.setPolicy(policy);
+			scheduleCompaction(result);
+		}
+	}
+
+	void Log::setRetention(const LogNameType& name, RetentionPolicy policy)
+	{
+		auto& result = record(name);
+		result.setPolicy(policy);
+		scheduleCompaction(result);
+	}
+
+	const RetentionPolicy& Log::retention() const noexcept
+	{
+		return _retention;
+	}
+
+	size_t Log::compact(size_t budget)
+	{
+		size_t discarded = 0;
+
+		while (!_pendingCompaction.empty() && discarded < budget)
+		{
+			discarded += _pendingCompaction.back()->compact();
+			_pendingCompaction.pop_back();
+		}
+
+		return discarded;
 	}
 
 	std::vector<LogNameType> Log::findKeys(const LogNameType& searchTerm) const noexcept
@@ -38,4 +170,136 @@ namespace Scenes
     {
         return _log.empty();
     }
+
+	size_t Log::memoryUsage() const noexcept
+	{
+		// Every entry of a hash table is a node holding its value and the next node, reached through a bucket.
+		size_t usage = sizeof(Log) + _log.bucket_count() * sizeof(void*) + _dependents.bucket_count() * sizeof(void*)
+			+ _pendingCompaction.capacity() * sizeof(LogRecord*);
+		for (const auto& [name, record] : _log)
+			usage += sizeof(void*) + sizeof(LogNameType) + stringMemoryUsage(name) + record.memoryUsage();
+		for (const auto& [name, flags] : _dependents)
+			usage += sizeof(void*) + sizeof(LogNameType) + stringMemoryUsage(name) + sizeof(DependentFlags)
+				+ flags.size() * sizeof(std::weak_ptr<bool>);
+
+		return usage;
+	}
+
+	void Log::setConcurrent(bool concurrent)
+	{
+		synchronize();
+		_concurrent = concurrent;
+	}
+
+	bool Log::concurrent() const noexcept
+	{
+		return _concurrent;
+	}
+
+	size_t Log::synchronize()
+	{
+		if (!_concurrent)
+			return 0;
+
+		const size_t applied = drainAppends();
+		if (applied > 0)
+			_epoch++;
+
+		return applied;
+	}
+
+	std::uint64_t Log::epoch() const noexcept
+	{
+		return _epoch;
+	}
+
+	void Log::setJournal(Journal* journal, std::uint8_t channel) noexcept
+	{
+		_journal = journal;
+		_journalChannel = channel;
+	}
+
+	void Log::addDependent(const LogNameType& name, std::weak_ptr<bool> flag) const
+	{
+		_dependents[name].add(std::move(flag));
+	}
+
+	void Log::writeSnapshot(SnapshotWriter& writer) const
+	{
+		_retention.write(writer);
+		writer.write<std::uint64_t>(_log.size());
+
+		for (const auto& [name, result] : _log)
+		{
+			writer.writeString(name);
+			result.write(writer);
+		}
+	}
+
+	void Log::readSnapshot(SnapshotReader& reader)
+	{
+		_retention = RetentionPolicy::read(reader);
+		_pendingCompaction.clear();
+		_log.clear();
+
+		const auto size = reader.read<std::uint64_t>();
+		for (std::uint64_t i = 0; i < size; i++)
+		{
+			auto name = reader.readString();
+			auto& result = _log.insert_or_assign(std::move(name), LogRecord::read(reader)).first->second;
+			scheduleCompaction(result);
+		}
+
+		for (auto& flags : _dependents | std::views::values)
+			flags.raise();
+	}
+
+	const LogRecord* Log::find(const LogNameType& name) const noexcept
+	{
+		const auto it = _log.find(name);
+
+		if (it == _log.end())
+			return nullptr;
+		return &it->second;
+	}
+
+	LogRecord& Log::record(const LogNameType& name)
+	{
+		return _log.try_emplace(name, _retention).first->second;
+	}
+
+	void Log::apply(const LogNameType& name) noexcept
+	{
+		append(record(name), _linesRead);
+		raiseDependents(name);
+
+		if (_journal)
+			_journal->logName(_journalChannel, _linesRead, name);
+	}
+
+	void Log::raiseDependents(const LogNameType& name) noexcept
+	{
+		const auto it = _dependents.find(name);
+		if (it != _dependents.end())
+			it->second.raise();
+	}
+
+	size_t Log::drainAppends()
+	{
+		return _queuedNames.drain([this](const LogNameType& name) { apply(name); });
+	}
+
+	void Log::append(LogRecord& record, size_t line) noexcept
+	{
+		record.append(std::max(line, record.last().value_or(0)));
+
+		if (!_pendingCompaction.empty())
+			compact(compactionStep);
+	}
+
+	void Log::scheduleCompaction(LogRecord& record)
+	{
+		if (record.needsCompaction())
+			_pendingCompaction.push_back(&record);
+	}
 } // Scenes
@@ -0,0 +1,408 @@
+#include "LogRecord.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Snapshot.hpp"
+#include "pch.h"
+
+namespace Scenes
+{
+	RetentionPolicy RetentionPolicy::keepAll() noexcept
+	{
+		return { Mode::KeepAll, 0 };
+	}
+
+	RetentionPolicy RetentionPolicy::keepLast(size_t limit) noexcept
+	{
+		return { Mode::KeepLast, limit };
+	}
+
+	RetentionPolicy RetentionPolicy::summary() noexcept
+	{
+		return { Mode::Summary, 0 };
+	}
+
+	void RetentionPolicy::write(SnapshotWriter& writer) const
+	{
+		writer.write(static_cast<std::uint8_t>(mode));
+		writer.write<std::uint64_t>(limit);
+	}
+
+	RetentionPolicy RetentionPolicy::read(SnapshotReader& reader)
+	{
+		const auto mode = reader.read<std::uint8_t>();
+		if (mode > static_cast<std::uint8_t>(Mode::Summary))
+			throw SnapshotError{ "Snapshot contains an unknown retention mode." };
+
+		return { static_cast<Mode>(mode), static_cast<size_t>(reader.read<std::uint64_t>()) };
+	}
+
+	namespace
+	{
+		void writeVarint(std::vector<std::uint8_t>& bytes, size_t value)
+		{
+			while (value >= 0x80)
+			{
+				bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+				value >>= 7;
+			}
+			bytes.push_back(static_cast<std::uint8_t>(value));
+		}
+
+		// Stops at the end of the bytes or after 64 bits, so a malformed varint never reads out of bounds.
+		size_t readVarint(const std::vector<std::uint8_t>& bytes, size_t& offset) noexcept
+		{
+			size_t value = 0;
+			for (int shift = 0; shift < 64 && offset < bytes.size(); shift += 7)
+			{
+				const auto byte = bytes[offset++];
+				value |= static_cast<size_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80))
+					break;
+			}
+			return value;
+		}
+	}
+
+	LogView::Iterator::Iterator() noexcept
+		: _bytes(nullptr), _offset(0), _index(0), _size(0), _line(0)
+	{}
+
+	LogView::Iterator::Iterator(const std::vector<std::uint8_t>* bytes, size_t index, size_t size) noexcept
+		: _bytes(bytes), _offset(0), _index(index), _size(size), _line(0)
+	{
+		if (_index < _size)
+			_line = readVarint(*_bytes, _offset);
+	}
+
+	size_t LogView::Iterator::operator*() const noexcept
+	{
+		return _line;
+	}
+
+	LogView::Iterator& LogView::Iterator::operator++() noexcept
+	{
+		if (++_index < _size)
+			_line += readVarint(*_bytes, _offset);
+		return *this;
+	}
+
+	LogView::Iterator LogView::Iterator::operator++(int) noexcept
+	{
+		auto previous = *this;
+		++*this;
+		return previous;
+	}
+
+	bool LogView::Iterator::operator==(const Iterator& rhs) const noexcept
+	{
+		return _index == rhs._index;
+	}
+
+	LogView::LogView() noexcept
+		: _bytes(nullptr), _size(0), _back(0)
+	{}
+
+	LogView::LogView(const std::vector<std::uint8_t>* bytes, size_t size, size_t back) noexcept
+		: _bytes(bytes), _size(size), _back(back)
+	{}
+
+	LogView::Iterator LogView::begin() const noexcept
+	{
+		return { _bytes, 0, _size };
+	}
+
+	LogView::Iterator LogView::end() const noexcept
+	{
+		return { _bytes, _size, _size };
+	}
+
+	size_t LogView::size() const noexcept
+	{
+		return _size;
+	}
+
+	bool LogView::empty() const noexcept
+	{
+		return _size == 0;
+	}
+
+	size_t LogView::back() const noexcept
+	{
+		return _back;
+	}
+
+	LogRecord::LogRecord(RetentionPolicy policy) noexcept
+		: _size(0), _tail(0), _first(0), _last(0), _count(0), _discardedThrough(0),
+		  _policy(policy)
+	{}
+
+	void LogRecord::append(size_t line)
+	{
+		if (_count == 0)
+			_first = line;
+		_last = line;
+		_count++;
+
+		if (_policy.mode == RetentionPolicy::Mode::Summary)
+		{
+			_discardedThrough = line;
+			return;
+		}
+
+		encode(line);
+
+		// Let KeepLast records grow to twice their limit before trimming, so each append costs O(1) amortized.
+		if (_policy.mode == RetentionPolicy::Mode::KeepLast && _size >= 2 * std::max<size_t>(_policy.limit, 1))
+			compact();
+	}
+
+	void LogRecord::setPolicy(RetentionPolicy policy) noexcept
+	{
+		_policy = policy;
+	}
+
+	size_t LogRecord::compact()
+	{
+		if (!needsCompaction())
+			return 0;
+
+		const size_t discarded = _size - retainedTarget();
+		std::vector<size_t> kept;
+		kept.reserve(_size - discarded);
+		auto line = retained().begin();
+		for (size_t i = 0; i < discarded; i++, ++line)
+			_discardedThrough = *line;
+		for (; line != retained().end(); ++line)
+			kept.push_back(*line);
+
+		_bytes.clear();
+		_skips.clear();
+		_size = 0;
+		for (const size_t keptLine : kept)
+			encode(keptLine);
+
+		_bytes.shrink_to_fit();
+		_skips.shrink_to_fit();
+
+		return discarded;
+	}
+
+	void LogRecord::merge(const LogRecord& other)
+	{
+		if (other.empty())
+			return;
+
+		const size_t discardedThrough = std::max(_discardedThrough, other._discardedThrough);
+		std::vector<size_t> kept;
+		kept.reserve(_size + other._size);
+		std::ranges::merge(retained(), other.retained(), std::back_inserter(kept));
+		std::erase_if(kept, [discardedThrough](size_t line) { return line <= discardedThrough; });
+
+		_first = empty() ? other._first : std::min(_first, other._first);
+		_last = empty() ? other._last : std::max(_last, other._last);
+		_count += other._count;
+		_discardedThrough = discardedThrough;
+
+		_bytes.clear();
+		_skips.clear();
+		_size = 0;
+		for (const size_t line : kept)
+			encode(line);
+
+		compact();
+	}
+
+	bool LogRecord::needsCompaction() const noexcept
+	{
+		return _size > retainedTarget();
+	}
+
+	LogView LogRecord::retained() const noexcept
+	{
+		return { &_bytes, _size, _tail };
+	}
+
+	std::optional<size_t> LogRecord::nthFromBack(size_t n) const
+	{
+		if (n >= _count)
+			return {};
+		if (n == 0)
+			return _last;
+		if (n >= _size)
+			throw DiscardedLogError{ "Occurrences up to line " + std::to_string(_discardedThrough) + " were discarded." };
+
+		// Start from the skip entry of the block holding the occurrence, and decode forward within that block.
+		const size_t index = _size - 1 - n;
+		const auto& skip = _skips[index / blockSize];
+		size_t offset = skip.offset;
+		size_t line = skip.line;
+		for (size_t rank = index / blockSize * blockSize; rank < index; rank++)
+			line += readVarint(_bytes, offset);
+
+		return line;
+	}
+
+	bool LogRecord::complete() const noexcept
+	{
+		return _size == _count;
+	}
+
+	bool LogRecord::empty() const noexcept
+	{
+		return _count == 0;
+	}
+
+	const RetentionPolicy& LogRecord::policy() const noexcept
+	{
+		return _policy;
+	}
+
+	std::optional<size_t> LogRecord::first() const noexcept
+	{
+		if (empty())
+			return {};
+		return _first;
+	}
+
+	std::optional<size_t> LogRecord::last() const noexcept
+	{
+		if (empty())
+			return {};
+		return _last;
+	}
+
+	size_t LogRecord::count() const noexcept
+	{
+		return _count;
+	}
+
+	size_t LogRecord::countBetween(size_t from, size_t to) const
+	{
+		if (empty() || from > to || to < _first || from > _last)
+			return 0;
+		if (from <= _first && to >= _last)
+			return _count;
+
+		// Line numbers only increase, so ranges starting past every discarded line number are exact.
+		if (!complete() && from <= _discardedThrough)
+			throw DiscardedLogError{ "Occurrences up to line " + std::to_string(_discardedThrough) + " were discarded." };
+
+		return seek(to, true).rank - seek(from, false).rank;
+	}
+
+	std::optional<size_t> LogRecord::firstAtOrAfter(size_t line) const
+	{
+		if (empty() || line > _last)
+			return {};
+		if (line <= _first)
+			return _first;
+		if (line == _last)
+			return _last;
+
+		if (!complete() && line <= _discardedThrough)
+			throw DiscardedLogError{ "Occurrences up to line " + std::to_string(_discardedThrough) + " were discarded." };
+
+		return seek(line, false).next;
+	}
+
+	size_t LogRecord::memoryUsage() const noexcept
+	{
+		return sizeof(LogRecord) + _bytes.capacity() + _skips.capacity() * sizeof(SkipEntry);
+	}
+
+	void LogRecord::write(SnapshotWriter& writer) const
+	{
+		_policy.write(writer);
+		for (const size_t value : { _size, _tail, _first, _last, _count, _discardedThrough })
+			writer.write<std::uint64_t>(value);
+
+		writer.writeArray(std::span<const std::uint8_t>(_bytes));
+		writer.writeArray(std::span<const SkipEntry>(_skips));
+	}
+
+	LogRecord LogRecord::read(SnapshotReader& reader)
+	{
+		LogRecord record{ RetentionPolicy::read(reader) };
+		for (size_t* value : { &record._size, &record._tail, &record._first, &record._last, &record._count,
+							   &record._discardedThrough })
+			*value = static_cast<size_t>(reader.read<std::uint64_t>());
+
+		reader.readArray(record._bytes);
+		reader.readArray(record._skips);
+
+		if (record._size > record._count || record._skips.size() != (record._size + blockSize - 1) / blockSize)
+			throw SnapshotError{ "Snapshot contains an inconsistent log record." };
+
+		// Decode every kept line number once, so later decoding can trust the bytes, skip entries and tail.
+		size_t offset = 0;
+		size_t line = 0;
+		for (size_t index = 0; index < record._size; index++)
+		{
+			const size_t start = offset;
+			const size_t delta = readVarint(record._bytes, offset);
+			if (offset == start || record._bytes[offset - 1] & 0x80 || delta > record._last - (index ? line : 0))
+				throw SnapshotError{ "Snapshot contains an inconsistent log record." };
+			line = index ? line + delta : delta;
+
+			if (index % blockSize == 0)
+			{
+				const auto& skip = record._skips[index / blockSize];
+				if (skip.offset != offset || skip.line != line)
+					throw SnapshotError{ "Snapshot contains an inconsistent log record." };
+			}
+		}
+		if (offset != record._bytes.size() || (record._size != 0 && record._tail != line))
+			throw SnapshotError{ "Snapshot contains an inconsistent log record." };
+
+		return record;
+	}
+
+	void LogRecord::encode(size_t line)
+	{
+		writeVarint(_bytes, line - (_size == 0 ? 0 : _tail));
+		if (_size % blockSize == 0)
+			_skips.push_back({ _bytes.size(), line });
+		_tail = line;
+		_size++;
+	}
+
+	LogRecord::SeekResult LogRecord::seek(size_t line, bool inclusive) const noexcept
+	{
+		const auto below = [line, inclusive](size_t value) { return inclusive ? value <= line : value < line; };
+
+		// Find the last block whose first line number is below line, then decode at most one block from there.
+		const auto block = std::ranges::partition_point(_skips, below, &SkipEntry::line);
+		if (block == _skips.begin())
+			return { 0, _skips.empty() ? std::optional<size_t>() : _skips.front().line };
+
+		const auto& skip = *std::prev(block);
+		size_t rank = static_cast<size_t>(std::prev(block) - _skips.begin()) * blockSize + 1;
+		size_t offset = skip.offset;
+		size_t value = skip.line;
+
+		while (rank < _size)
+		{
+			value += readVarint(_bytes, offset);
+			if (!below(value))
+				return { rank, value };
+			rank++;
+		}
+
+		return { rank, {} };
+	}
+
+	size_t LogRecord::retainedTarget() const noexcept
+	{
+		switch (_policy.mode)
+		{
+			case RetentionPolicy::Mode::KeepLast:
+				return std::min(_size, _policy.limit);
+			case RetentionPolicy::Mode::Summary:
+				return 0;
+			default:
+				return _size;
+		}
+	}
+} // Scenes
@@ -0,0 +1,127 @@
+#include "Pacing.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include "pch.h"
+
+namespace Scenes
+{
+    void Pacing::awaitNextLine()
+    {
+        using namespace std::chrono_literals;
+
+        while (!ready(Clock::now()))
+            std::this_thread::sleep_until(nextDeadline().value_or(Clock::now() + 1ms));
+    }
+
+    void HeadlessPacing::lineRead(const Line&)
+    {}
+
+    bool HeadlessPacing::ready(Clock::time_point)
+    {
+        return true;
+    }
+
+    std::optional<Pacing::Clock::time_point> HeadlessPacing::nextDeadline()
+    {
+        return Clock::time_point::min();
+    }
+
+    bool DeadlinePacing::ready(Clock::time_point now)
+    {
+        std::lock_guard lock(_mutex);
+        return now >= _deadline;
+    }
+
+    std::optional<Pacing::Clock::time_point> DeadlinePacing::nextDeadline()
+    {
+        std::lock_guard lock(_mutex);
+        return _deadline;
+    }
+
+    void DeadlinePacing::awaitNextLine()
+    {
+        std::unique_lock lock(_mutex);
+
+        // Wait again after waking, as the deadline may have been moved while this thread was asleep.
+        while (Clock::now() < _deadline)
+            _skipped.wait_until(lock, _deadline);
+    }
+
+    void DeadlinePacing::skip()
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _deadline = Clock::time_point::min();
+        }
+        _skipped.notify_all();
+    }
+
+    void DeadlinePacing::setDeadline(Clock::time_point deadline)
+    {
+        std::lock_guard lock(_mutex);
+        _deadline = deadline;
+    }
+
+    FixedPacing::FixedPacing(Clock::duration delay) noexcept
+        : _delay(delay)
+    {}
+
+    void FixedPacing::lineRead(const Line&)
+    {
+        setDeadline(Clock::now() + _delay);
+    }
+
+    TypewriterPacing::TypewriterPacing(Clock::duration perCharacter, Clock::duration minimum) noexcept
+        : _perCharacter(perCharacter), _minimum(minimum)
+    {}
+
+    void TypewriterPacing::lineRead(const Line& line)
+    {
+        const auto typing = _perCharacter * static_cast<Clock::rep>(line.text().size());
+        setDeadline(Clock::now() + std::max(typing, _minimum));
+    }
+
+    void TickedPacing::lineRead(const Line&)
+    {
+        std::lock_guard lock(_mutex);
+        if (_ticks > 0)
+            _ticks--;
+    }
+
+    bool TickedPacing::ready(Clock::time_point)
+    {
+        std::lock_guard lock(_mutex);
+        return _ticks > 0;
+    }
+
+    std::optional<Pacing::Clock::time_point> TickedPacing::nextDeadline()
+    {
+        std::lock_guard lock(_mutex);
+        if (_ticks == 0)
+            return {};
+        return Clock::time_point::min();
+    }
+
+    void TickedPacing::awaitNextLine()
+    {
+        std::unique_lock lock(_mutex);
+        _ticked.wait(lock, [this] { return _ticks > 0; });
+    }
+
+    void TickedPacing::tick(size_t lines)
+    {
+        {
+            std::lock_guard lock(_mutex);
+            _ticks += lines;
+        }
+        _ticked.notify_one();
+    }
+
+    size_t TickedPacing::pendingTicks()
+    {
+        std::lock_guard lock(_mutex);
+        return _ticks;
+    }
+} // Scenes
@@ -1,5 +1,6 @@
 #include "Reader.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <fstream>
@@ -8,238 +9,642 @@
 #include <nlohmann/json.hpp>
 
 #include "Serializations.hpp"
+#include "Snapshot.hpp"
 #include "pch.h"
 
-// TODO: Save Reader to saveLoc.
-//  Save section parts individually
-//  Save Event/Scene Logs
-//  Save starting scene file into _saveLoc with read sections removed.
-
 namespace Scenes
 {
-#pragma region Add Events
-    void Reader::addCustomEvent(const std::string& name, const std::function<int(std::string)>& func)
+#pragma region File Manipulation
+    namespace
     {
-        _events.emplace(name, Event(func, name, _eventLog));
+        const std::filesystem::path snapshotFile{ "Snapshot.bin" }; //!< The snapshot saved into the save directory.
+        const std::filesystem::path journalFile{ "Journal.bin" }; //!< The journal kept in the save directory.
+
+        constexpr std::uint8_t sceneChannel = 0; //!< Identifies the scene log in the journal.
+        constexpr std::uint8_t eventChannel = 1; //!< Identifies the event log in the journal.
+        constexpr std::uint8_t nextSceneChannel = 2; //!< Identifies the Scene set to follow by setNextScene.
+
+        bool isDirectory(const std::filesystem::path& path, const std::string& name)
+        {
+            auto it = path.end();
+            while (!path.empty() && (it == path.end() || (it != path.begin() && *it == "")))
+                it--;
+
+            return *it == name;
+        }
+
+        std::filesystem::path sceneFilePath(const std::string& fileName, std::filesystem::path containedDirectory)
+        {
+            containedDirectory /= fileName;
+            containedDirectory.replace_extension("json");
+
+            return containedDirectory;
+        }
+
+        std::ifstream openSceneFile(const std::string& fileName, std::filesystem::path containedDirectory)
+        {
+            return {sceneFilePath(fileName, std::move(containedDirectory))};
+        }
+
+        void initializeSaveFile(std::filesystem::path& saveDirectory)
+        {
+            const static std::filesystem::path sceneSave{ "Globals" };
+            if (!isDirectory(saveDirectory, "Scenes"))
+                saveDirectory /= "Scenes/";
+
+            // Optimize: Replace extension to json to prevent user errors.
+            auto sceneFile = openSceneFile(sceneSave, saveDirectory);
+        }
+
+        std::string findStartScene(const std::string& saveName, std::filesystem::path saveDirectory)
+        {
+            auto saveFile = openSceneFile(saveName, std::move(saveDirectory));
+            if (!saveFile)
+                return "";
+
+            return nlohmann::json::parse(saveFile).value("current scene", "");
+        }
+
+        std::vector<Line> parseLines(const nlohmann::json& linesJson)
+        {
+            std::vector<Line> lines;
+            lines.reserve(linesJson.size());
+            for (const auto& line : linesJson)
+                lines.push_back(line.get<Line>());
+
+            return lines;
+        }
     }
 
-    void Reader::addEvent(const std::string& name, const std::function<int(std::string)>& func)
+    std::optional<std::pair<std::filesystem::path, std::filesystem::file_time_type> > Reader::findSceneFile(
+        const std::string& sceneName) const
     {
-        addCustomEvent(name, func);
+        // Scene files in the save directory take the place of the default ones.
+        for (const auto& directory : { _saveLoc, _sceneLoc })
+        {
+            std::error_code error;
+            auto path = sceneFilePath(sceneName, directory);
+            const auto modified = std::filesystem::last_write_time(path, error);
+            if (!error)
+                return std::pair{ std::move(path), modified };
+        }
+
+        return {};
     }
 
-    void Reader::addEvent(const std::string& name, const std::function<void(std::string)>& func)
+    bool Reader::loadScene()
     {
-        std::function<int(std::string)> converted = [func](std::string arg) -> int {
-            func(std::move(arg));
-            return 0;
-        };
+        const auto sceneName = std::exchange(_session.nextScene, "");
+        _session.sceneLog.addLog(sceneName);
+
+        const auto file = findSceneFile(sceneName);
+        if (!file)
+            return false;
+
+        const auto& [path, modified] = *file;
+        auto scene = _sceneCache.find(path, modified);
+        if (!scene)
+        {
+            // A Scene parsed ahead is waited for rather than parsed again, as it has a head start.
+            std::optional<ParsedScene> parsed;
+            const auto prefetch = _prefetches.find(path.string());
+            if (prefetch != _prefetches.end() && prefetch->second.modified == modified)
+            {
+                auto prefetched = std::move(prefetch->second.scene);
+                _prefetches.erase(prefetch);
+                parsed = prefetched.get();
+                _prefetchedScenes++;
+            }
+            else
+                parsed = readSceneFile(path);
 
-        addCustomEvent(name, converted);
+            if (!parsed)
+                return false;
+            scene = buildScene(std::move(*parsed));
+            _sceneCache.insert(path, modified, scene);
+        }
+
+        _session.sceneName = sceneName;
+        _session.sectionIndex = 0;
+        for (const auto& section : *scene)
+            linkSection(_session.scene.emplace_back(section), sceneName);
+
+        prefetchNextScenes(*scene);
+        return true;
     }
 
-    void Reader::addEvent(const std::string& name, const std::function<int(void)>& func)
+    std::optional<Reader::ParsedScene> Reader::readSceneFile(const std::filesystem::path& path)
     {
-        std::function<int(std::string)> converted = [func](const std::string&) -> int {
-            return func();
-        };
+        std::ifstream sceneFile{ path };
+        if (!sceneFile)
+            return {};
+
+        const auto sceneJson = nlohmann::json::parse(sceneFile);
+        ParsedScene scene;
+        scene.reserve(sceneJson.size());
+        for (const auto& val : sceneJson)
+            scene.emplace_back(parseLines(val.value("lines", nlohmann::json::array())),
+                               val.value("conditions", Section::ConditionVector()));
 
-        addCustomEvent(name, converted);
+        return scene;
     }
 
-    void Reader::addEvent(const std::string& name, const std::function<void(void)>& func)
+    SceneCache::Scene Reader::buildScene(ParsedScene parsed)
     {
-        std::function<int(std::string)> converted = [func](const std::string&) -> int {
-            func();
-            return 0;
-        };
+        auto scene = std::make_shared<std::vector<Section> >();
+        scene->reserve(parsed.size());
+        for (auto& [lines, conditions] : parsed)
+        {
+            // Linked once here, so copies entering the Scene share Lines that are already linked.
+            scene->emplace_back(std::move(lines), _session.sceneLog, _session.eventLog, std::move(conditions))
+                .link(_events, [](const Line&) {});
+        }
 
-        addCustomEvent(name, converted);
+        return scene;
     }
 
-    template<class Ret>
-    void Reader::addEvent(const std::string& name, std::function<Ret(std::string)> func, std::function<int(Ret)> toInt)
+    void Reader::prefetchNextScenes(const std::vector<Section>& scene)
     {
-        std::function<int(std::string)> converted = [func, toInt](std::string arg) -> int {
-            return toInt(func(std::move(arg)));
-        };
+        if (!_prefetching)
+            return;
+
+        std::unordered_map<std::string, Prefetch> prefetches;
+        for (const auto& section : scene)
+            for (const auto& line : *section.lines())
+                for (const auto& call : line.events())
+                {
+                    if (call.name != "setNextScene")
+                        continue;
+
+                    const auto file = findSceneFile(call.arg);
+                    if (!file || prefetches.contains(file->first.string())
+                        || _sceneCache.contains(file->first, file->second))
+                        continue;
+
+                    auto key = file->first.string();
+                    if (const auto started = _prefetches.find(key);
+                        started != _prefetches.end() && started->second.modified == file->second)
+                    {
+                        prefetches.emplace(std::move(key), std::move(started->second));
+                        continue;
+                    }
+
+                    if (!_prefetchPool)
+                        _prefetchPool = std::make_unique<EventPool>(1, 64);
+
+                    std::packaged_task<std::optional<ParsedScene>()> task{ [path = file->first] {
+                        return readSceneFile(path);
+                    } };
+                    prefetches.emplace(std::move(key), Prefetch{ file->second, task.get_future() });
+                    _prefetchPool->submit(std::move(task));
+                }
+
+        // Scenes that can't follow this one any more are left to finish parsing and dropped.
+        _prefetches.swap(prefetches);
+    }
+
+    bool Reader::saveScene()
+    {
+        if (!_saving)
+            return false;
 
-        addCustomEvent(name, converted);
+        // A snapshot can't hold running Events, so log them first.
+        logAsyncEvents({}, true);
+        try
+        {
+            saveSnapshot(_saveLoc / snapshotFile);
+            if (_journal)
+                _journal->clear();
+        } catch (SnapshotError&)
+        {
+            return false;
+        } catch (JournalError&)
+        {
+            return false;
+        }
+
+        return true;
     }
 
-    template<class Ret>
-    void Reader::addEvent(const std::string& name, std::function<Ret(void)> func, std::function<int(Ret)> toInt)
+    void Reader::saveSnapshot(const std::filesystem::path& path) const
     {
-        std::function<int(std::string)> converted = [func, toInt](const std::string&) -> int {
-            return toInt(func());
-        };
+        SnapshotWriter writer;
+        writer.writeHeader();
+        writer.write<std::uint64_t>(_session.linesRead);
+        writer.writeString(_session.nextScene);
+
+        _session.eventLog.writeSnapshot(writer);
+        _session.sceneLog.writeSnapshot(writer);
 
-        addCustomEvent(name, converted);
+        writer.write<std::uint64_t>(_session.scene.size());
+        for (const auto& section : _session.scene)
+            section.writeSnapshot(writer);
+
+        writer.saveTo(path);
     }
 
-    template<class Arg>
-    void Reader::addEvent(const std::string& name, std::function<int(Arg)> func,
-                          std::function<Arg(std::string)> fromString)
+    size_t Reader::replayJournal(const std::filesystem::path& path)
     {
-        std::function<int(std::string)> converted = [func, fromString](std::string arg) -> int {
-            return func(fromString(std::move(arg)));
-        };
+        // Maps the Event ids of the journal to those of _session.eventLog, along with the name each was interned for.
+        std::vector<std::pair<std::string, std::optional<EventId> > > ids;
 
-        addCustomEvent(name, converted);
+        return Journal::replay(path, [&](const JournalEntry& entry)
+        {
+            // Asynchronous Events are journaled at the line that ran them, which may be before the lines read.
+            _session.linesRead = std::max(_session.linesRead, entry.line);
+
+            switch (entry.kind)
+            {
+                case JournalEntry::Kind::Name:
+                    if (entry.channel == sceneChannel)
+                    {
+                        _session.nextScene = entry.name;
+                        loadScene();
+                    }
+                    else if (entry.channel == nextSceneChannel)
+                        _session.nextScene = entry.name;
+                    else
+                        _session.eventLog.addLog(std::string(entry.name));
+                    break;
+                case JournalEntry::Kind::Event:
+                {
+                    if (ids.size() <= entry.key.id)
+                        ids.resize(entry.key.id + 1);
+
+                    // Each process appending to the journal numbers its Events from 0, so an id can be redefined.
+                    auto& [name, id] = ids[entry.key.id];
+                    if (!id || name != entry.name)
+                    {
+                        name = entry.name;
+                        id = _session.eventLog.intern(name);
+                    }
+                    _session.eventLog.addLog(EventKey{ *id, entry.key.returnValue }, entry.line);
+                    break;
+                }
+                case JournalEntry::Kind::Line:
+                    if (_session.scene.empty() || _session.scene.front().empty())
+                        throw JournalError{ "Journal reads a Line the saved Scene doesn't have." };
+                    _session.scene.front().skipLine();
+                    break;
+                case JournalEntry::Kind::SectionEnd:
+                    if (_session.scene.empty())
+                        throw JournalError{ "Journal finishes a Section the saved Scene doesn't have." };
+                    _session.scene.pop_front();
+                    break;
+            }
+        });
     }
 
-    template<class Arg>
-    void Reader::addEvent(const std::string& name, std::function<void(Arg)> func,
-                          std::function<Arg(std::string)> fromString)
+    void Reader::loadSnapshot(const std::filesystem::path& path)
     {
-        std::function<int(std::string)> converted = [func, fromString](std::string arg) -> int {
-            func(fromString(std::move(arg)));
-            return 1;
-        };
+        const MappedFile file{ path };
+        SnapshotReader reader{ file.data() };
+        reader.readHeader();
+
+        const auto linesRead = static_cast<size_t>(reader.read<std::uint64_t>());
+        auto nextScene = reader.readString();
+
+        _session.eventLog.readSnapshot(reader);
+        _session.sceneLog.readSnapshot(reader);
+
+        std::deque<Section> scene;
+        const auto sceneSize = reader.read<std::uint64_t>();
+        for (std::uint64_t i = 0; i < sceneSize; i++)
+            scene.emplace_back(reader, _session.sceneLog, _session.eventLog);
+        for (auto& section : scene)
+            linkSection(section, "");
+
+        if (!reader.atEnd())
+            throw SnapshotError{ "Snapshot " + path.string() + " has trailing data." };
+
+        _session.linesRead = linesRead;
+        _session.nextScene = std::move(nextScene);
+        _session.scene.swap(scene);
+        _session.sceneName.clear();
+        _session.sectionIndex = 0;
+    }
+#pragma endregion
 
-        addCustomEvent(name, converted);
+    void Reader::synchronizeLogs()
+    {
+        logAsyncEvents({}, false);
+        _session.eventLog.synchronize();
+        _session.sceneLog.synchronize();
     }
 
-    template<class Ret, class Arg>
-    void Reader::addEvent(
-        const std::string& name, std::function<Ret(Arg)> func, std::function<int(Ret)> toInt,
-        std::function<Arg(std::string)> fromString)
+    void Reader::startAsyncEvent(EventId id, EventFunction<int()> call)
     {
-        std::function<int(std::string)> converted = [func, toInt, fromString](std::string arg) -> int {
-            return ToInt(func(fromString(std::move(arg))));
-        };
+        if (!_eventPool)
+            _eventPool = std::make_unique<EventPool>(_eventWorkers, _eventCapacity);
 
-        addCustomEvent(name, converted);
+        std::packaged_task<int()> task{ std::move(call) };
+        auto result = task.get_future();
+        _eventPool->submit(std::move(task));
+        _session.pendingEvents.push_back({ id, _session.linesRead, std::move(result) });
     }
-#pragma endregion
 
-#pragma region File Manipulation
-    namespace
+    void Reader::logAsyncEvents(const std::vector<EventId>& awaited, bool awaitAll)
     {
-        bool isDirectory(const std::filesystem::path& path, const std::string& name)
+        using namespace std::chrono_literals;
+
+        // Results of the same Event are logged in the order their calls started, so a call still running holds back
+        // every later call of its Event.
+        std::vector<EventId> heldBack;
+        for (auto it = _session.pendingEvents.begin(); it != _session.pendingEvents.end();)
         {
-            auto it = path.end();
-            while (!path.empty() && ((it != path.begin() && *it == "") || it == path.end()))
-                it--;
+            const bool isHeldBack = std::ranges::find(heldBack, it->id) != heldBack.end();
+            const bool isAwaited = awaitAll || std::ranges::find(awaited, it->id) != awaited.end();
+            if (isHeldBack || (!isAwaited && it->result.wait_for(0s) != std::future_status::ready))
+            {
+                if (!isHeldBack)
+                    heldBack.push_back(it->id);
+                ++it;
+                continue;
+            }
 
-            return *it == name;
+            // Removed before getting the result, so a rethrown exception leaves no call behind.
+            auto pending = std::move(*it);
+            it = _session.pendingEvents.erase(it);
+            _session.eventLog.addLog(EventKey{ pending.id, pending.result.get() }, pending.line);
         }
+    }
 
-        std::ifstream openSceneFile(const std::string& fileName, std::filesystem::path containedDirectory)
+    void Reader::awaitAsyncEvents(const Section& section)
+    {
+        if (_session.pendingEvents.empty())
+            return;
+
+        std::vector<EventId> awaited;
+        for (const auto& name : section.eventNames())
+            if (const auto id = _session.eventLog.findId(name))
+                awaited.push_back(*id);
+
+        logAsyncEvents(awaited, false);
+    }
+
+    bool Reader::actOnSignals()
+    {
+        if (const auto pause = _session.eventLog.last(_pauseSignal); pause && *pause > _session.lastPauseSignal)
         {
-            containedDirectory /= fileName;
-            containedDirectory.replace_extension("json");
+            _session.lastPauseSignal = *pause;
+            return true; // runPause()
+        }
+        if (const auto stop = _session.eventLog.last(_stopSignal); stop && *stop > _session.lastStopSignal)
+        {
+            _session.lastStopSignal = *stop;
+            saveScene();
+            return true; // runStop()
+        }
+        return false;
+    }
+
+    bool Reader::reachNextLine()
+    {
+        while (_session.reading)
+        {
+            if (_session.scene.empty())
+            {
+                _session.reading = loadScene();
+                continue;
+            }
+
+            if (!_session.sectionEntered)
+            {
+                synchronizeLogs();
+                awaitAsyncEvents(_session.scene.front());
+                _session.sectionEntered = true;
+            }
 
-            return {containedDirectory};
+            if (_session.scene.front().isActive() && !actOnSignals())
+            {
+                if (!_session.sectionStarted && _sectionObserver)
+                    _sectionObserver(_session.sceneName, _session.sectionIndex);
+                _session.sectionStarted = true;
+                return true;
+            }
+
+            _session.scene.pop_front();
+            _session.sectionIndex++;
+            _session.sectionEntered = _session.sectionStarted = false;
+
+            if (_journal)
+                _journal->logProgress(JournalEntry::Kind::SectionEnd, _session.linesRead);
         }
 
-        void initializeSaveFile(std::filesystem::path& saveDirectory)
+        logAsyncEvents({}, true);
+        return false;
+    }
+
+    void Reader::readNextLine(std::ostream& stream)
+    {
+        // Optimize: Figure out how to implement a custom display method
+        _pacing->lineRead(_session.scene.front().nextLine());
+        _session.scene.front().readLine(stream, _events);
+        synchronizeLogs();
+        _session.linesRead++;
+        if (_journal)
+            _journal->logProgress(JournalEntry::Kind::Line, _session.linesRead);
+        awaitAsyncEvents(_session.scene.front());
+    }
+
+    void Reader::read(std::ostream& stream)
+    {
+        start();
+        readScenes(stream);
+    }
+
+    void Reader::start()
+    {
+        // Resume from the last snapshot if there is one, as it already holds the unread Sections of its Scene.
+        bool loadedScene = false;
+        if (std::filesystem::exists(_saveLoc / snapshotFile))
         {
-            const static std::filesystem::path sceneSave{ "Globals" };
-            if (!isDirectory(saveDirectory, "Scenes"))
-                saveDirectory /= "Scenes/";
+            loadSnapshot(_saveLoc / snapshotFile);
+            loadedScene = true;
+        }
 
-            // Optimize: Replace extension to json to prevent user errors.
-            auto sceneFile = openSceneFile(sceneSave, saveDirectory);
+        // Then redo whatever was read after that snapshot, and journal everything read from here on.
+        if (_journalOptions)
+        {
+            if (replayJournal(_saveLoc / journalFile) > 0)
+                loadedScene = true;
+
+            _journal = std::make_unique<Journal>(_saveLoc / journalFile, *_journalOptions);
+            _session.sceneLog.setJournal(_journal.get(), sceneChannel);
+            _session.eventLog.setJournal(_journal.get(), eventChannel);
         }
 
-        std::string findStartScene(const std::string& saveName, std::filesystem::path saveDirectory)
+        if (!loadedScene)
         {
-            auto saveFile = openSceneFile(saveName, std::move(saveDirectory));
-            if (!saveFile)
-                return "";
+            _session.nextScene = findStartScene(_startScene, _saveLoc);
+            if (_session.nextScene.empty())
+                throw std::out_of_range("Entry Scene File " + _startScene + " doesn't exist.");
 
-            return nlohmann::json::parse(saveFile).value("current scene", "");
+            loadedScene = loadScene();
         }
+
+        _session.reading = loadedScene;
     }
 
-    bool Reader::loadScene()
+    bool Reader::step(std::ostream& stream)
     {
-        _sceneLog.addLog(_nextScene);
-
-        auto sceneFile = openSceneFile(_nextScene, _saveLoc);
-        if (!sceneFile)
-            sceneFile = openSceneFile(_nextScene, _sceneLoc);
-        if (!sceneFile)
+        if (!reachNextLine())
             return false;
 
-        auto sceneJson = nlohmann::json::parse(sceneFile);
-        for (auto& val : sceneJson)
-            _scene.emplace(val.value("lines", {}), _sceneLog, _eventLog, val.value("conditions", {}));
-
+        if (_pacing->ready(Pacing::Clock::now()))
+            readNextLine(stream);
         return true;
     }
 
-    bool Reader::saveScene()
+    void Reader::readFrom(const std::string& sceneName, std::ostream& stream)
     {
-        const static std::filesystem::path sceneSave{ "Globals" };
-        auto globals = openSceneFile(sceneSave, _saveLoc);
-        if (!globals)
-            return false;
-
-        for (auto& section : std::deque<Section>(_scene))
+        const bool saving = std::exchange(_saving, false);
+        try
+        {
+            _session.nextScene = sceneName;
+            _session.reading = loadScene();
+            readScenes(stream);
+        } catch (...)
         {
+            _saving = saving;
+            throw;
+        }
+        _saving = saving;
+    }
 
+    void Reader::readScenes(std::ostream& stream)
+    {
+        while (reachNextLine())
+        {
+            _pacing->awaitNextLine();
+            readNextLine(stream);
         }
     }
-#pragma endregion
 
-    void Reader::readSectionIfValid(std::ostream& stream)
+    void Reader::setSectionObserver(std::function<void(const std::string&, size_t)> observer)
     {
-        using namespace std::chrono_literals;
+        _sectionObserver = std::move(observer);
+    }
 
-        static const std::string pauseSignal = createEventString("pause", 1);
-        static const std::string stopSignal = createEventString("stop", 1);
+    const EventLog& Reader::eventLog() const noexcept
+    {
+        return _session.eventLog;
+    }
+
+    const Log& Reader::sceneLog() const noexcept
+    {
+        return _session.sceneLog;
+    }
+
+    size_t Reader::memoryUsage() const noexcept
+    {
+        size_t usage = sizeof(Reader) - sizeof(EventLog) - sizeof(Log) + _session.eventLog.memoryUsage()
+                       + _session.sceneLog.memoryUsage() + stringMemoryUsage(_session.nextScene)
+                       + stringMemoryUsage(_session.sceneName) + _session.pendingEvents.size() * sizeof(PendingEvent)
+                       + _session.unresolvedEvents.capacity() * sizeof(UnresolvedEvent) + _sceneCache.memoryUsage();
+        for (const auto& section : _session.scene)
+            usage += section.memoryUsage();
+
+        return usage;
+    }
+
+    Reader::Reader(std::string sceneLoc, std::string saveLoc, std::string startSceneName)
+        : Reader(std::move(sceneLoc), std::move(saveLoc), std::move(startSceneName), [](EventLog&) {
+            return EventMap();
+        })
+    {}
 
-        static size_t lastPauseSignal = 0;
-        static size_t lastStopSignal = 0;
+    Reader::Session::Session()
+        : linesRead(0), eventLog(linesRead), sceneLog(linesRead), sectionIndex(0), lastPauseSignal(0),
+          lastStopSignal(0), reading(false), sectionEntered(false), sectionStarted(false)
+    {}
+
+    Reader::Reader(std::string sceneLoc, std::string saveLoc, std::string startSceneName,
+                   EventMap (* createEvents)(EventLog&))
+        : _sceneLoc(std::move(sceneLoc)), _saveLoc(std::move(saveLoc)), _startScene(std::move(startSceneName)),
+          _events(createEvents(_session.eventLog)), _prefetching(true), _prefetchedScenes(0),
+          _pauseSignal{ _session.eventLog.intern("pause"), 1 }, _stopSignal{ _session.eventLog.intern("stop"), 1 },
+          _saving(true), _pacing(std::make_shared<FixedPacing>(std::chrono::milliseconds(500))),
+          _eventWorkers(std::max(std::thread::hardware_concurrency(), 1u)), _eventCapacity(64)
+    {
+        addCustomEvent("", [](const EventArgument&) -> int { return 0; });
+        addCustomEvent("setNextScene", [this](const EventArgument& arg) -> int {
+            _session.nextScene = arg.get<std::string>();
+            if (_journal)
+                _journal->logName(nextSceneChannel, _session.linesRead, _session.nextScene);
+            return 0;
+        });
+        initializeSaveFile(_saveLoc);
+    }
 
-        while (_scene.front().isActive())
+    void Reader::linkSection(Section& section, const std::string& sceneName)
+    {
+        section.link(_events, [&](const Line& line)
         {
-            if (_eventLog.query(pauseSignal).back() > lastPauseSignal)
-            {
-                lastPauseSignal = _eventLog.query(pauseSignal).back();
-                break; // runPause()
-            }
-            if (_eventLog.query(stopSignal).back() > lastStopSignal)
-            {
-                lastStopSignal = _eventLog.query(stopSignal).back();
-                break; // runStop(), saveScene()
-            }
+            for (const auto& call : line.events())
+                if (call.index == EventMap::noEvent)
+                    _session.unresolvedEvents.push_back({ sceneName, call.name, line.text() });
+        });
+    }
 
-            // Optimize: Figure out how to implement a custom display method
-            _scene.front().readLine(stream, _events);
-            std::this_thread::sleep_for(0.5s);
-        }
+    bool Reader::hasEvent(const std::string& name) const noexcept
+    {
+        return _events.contains(name);
     }
 
-    void Reader::read(std::ostream& stream)
+    const std::vector<UnresolvedEvent>& Reader::unresolvedEvents() const noexcept
     {
-        _nextScene = findStartScene(_startScene, _saveLoc);
-        if (_nextScene.empty())
-            throw std::out_of_range("Entry Scene File " + _startScene + " doesn't exist.");
+        return _session.unresolvedEvents;
+    }
 
-        bool loadedScene = loadScene();
-        do
-        {
-            _nextScene = "";
-            while (loadedScene && !_scene.empty())
-            {
-                readSectionIfValid(stream);
-                _scene.pop();
-            }
-            loadedScene = loadScene();
-        } while (loadedScene);
+    void Reader::setConcurrentEvents(bool concurrent)
+    {
+        _session.eventLog.setConcurrent(concurrent);
     }
 
-    Reader::Reader(std::string sceneLoc, std::string saveLoc, std::string startSceneName)
-        : _linesRead(0), _eventLog(_linesRead), _sceneLog(_linesRead),
-          _sceneLoc(std::move(sceneLoc)), _saveLoc(std::move(saveLoc)), _startScene(std::move(startSceneName)),
-          _nextScene(), _events({
-              {"", Event<std::string>([](const std::string& s) -> int { return 0; }, "", _eventLog)}
-          })
+    void Reader::setSceneCacheCapacity(size_t capacity)
     {
-        initializeSaveFile(_saveLoc);
+        _sceneCache.setCapacity(capacity);
+    }
+
+    const SceneCache& Reader::sceneCache() const noexcept
+    {
+        return _sceneCache;
+    }
+
+    void Reader::setPrefetching(bool prefetching)
+    {
+        _prefetching = prefetching;
+        if (!prefetching)
+            _prefetches.clear();
+    }
+
+    size_t Reader::prefetchedScenes() const noexcept
+    {
+        return _prefetchedScenes;
+    }
+
+    void Reader::setPacing(std::shared_ptr<Pacing> pacing)
+    {
+        _pacing = pacing ? std::move(pacing) : std::make_shared<HeadlessPacing>();
+    }
+
+    void Reader::setEventWorkers(size_t workers, size_t capacity)
+    {
+        logAsyncEvents({}, true);
+        _eventPool.reset();
+        _eventWorkers = workers;
+        _eventCapacity = capacity;
+    }
+
+    size_t Reader::pendingEvents() const noexcept
+    {
+        return _session.pendingEvents.size();
+    }
+
+    void Reader::enableJournal(JournalOptions options)
+    {
+        _journalOptions = options;
     }
 
     Reader::Reader(std::string sceneLoc, std::string saveLoc)
@@ -0,0 +1,101 @@
+#include "SceneCache.hpp"
+
+#include "pch.h"
+
+namespace Scenes
+{
+    SceneCache::SceneCache(size_t capacity) noexcept
+        : _capacity(capacity), _memory(0), _hits(0), _misses(0)
+    {}
+
+    SceneCache::Scene SceneCache::find(const std::filesystem::path& path, std::filesystem::file_time_type modified)
+    {
+        const auto found = _index.find(path.string());
+        if (found == _index.end() || found->second->modified != modified)
+        {
+            if (found != _index.end())
+                erase(found->second);
+            _misses++;
+            return nullptr;
+        }
+
+        _entries.splice(_entries.begin(), _entries, found->second);
+        _hits++;
+        return found->second->scene;
+    }
+
+    bool SceneCache::contains(const std::filesystem::path& path, std::filesystem::file_time_type modified) const
+    {
+        const auto found = _index.find(path.string());
+        return found != _index.end() && found->second->modified == modified;
+    }
+
+    void SceneCache::insert(const std::filesystem::path& path, std::filesystem::file_time_type modified, Scene scene)
+    {
+        // Measured before the Scene is copied from, while its Sections are the only ones holding their Lines.
+        size_t memory = sizeof(Entry) + sizeof(std::vector<Section>) + path.native().size();
+        for (const auto& section : *scene)
+            memory += section.memoryUsage();
+
+        if (const auto found = _index.find(path.string()); found != _index.end())
+            erase(found->second);
+        if (memory > _capacity)
+            return;
+
+        _entries.push_front({ path.string(), modified, std::move(scene), memory });
+        _index.emplace(_entries.front().path, _entries.begin());
+        _memory += memory;
+        evict();
+    }
+
+    void SceneCache::setCapacity(size_t capacity)
+    {
+        _capacity = capacity;
+        evict();
+    }
+
+    void SceneCache::clear() noexcept
+    {
+        _index.clear();
+        _entries.clear();
+        _memory = 0;
+    }
+
+    size_t SceneCache::capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    size_t SceneCache::memoryUsage() const noexcept
+    {
+        return _memory;
+    }
+
+    size_t SceneCache::size() const noexcept
+    {
+        return _entries.size();
+    }
+
+    size_t SceneCache::hits() const noexcept
+    {
+        return _hits;
+    }
+
+    size_t SceneCache::misses() const noexcept
+    {
+        return _misses;
+    }
+
+    void SceneCache::erase(std::list<Entry>::iterator entry) noexcept
+    {
+        _memory -= entry->memory;
+        _index.erase(entry->path);
+        _entries.erase(entry);
+    }
+
+    void SceneCache::evict() noexcept
+    {
+        while (_memory > _capacity && !_entries.empty())
+            erase(std::prev(_entries.end()));
+    }
+} // Scenes
@@ -1,247 +1,590 @@
 #include "Section.hpp"
 
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
 #include <stdexcept>
+#include <tuple>
 
 #include "pch.h"
 
 #include "Event.hpp"
 #include "Line.hpp"
+#include "Snapshot.hpp"
 
 namespace Scenes
 {
+    namespace
+    {
+        void writeSnapshotLine(SnapshotWriter& writer, const Line& line)
+        {
+            writer.writeString(line.text());
+            writer.write<std::uint64_t>(line.events().size());
+            for (const auto& call : line.events())
+            {
+                writer.writeString(call.name);
+                writer.writeString(call.arg);
+            }
+        }
+
+        Line readSnapshotLine(SnapshotReader& reader)
+        {
+            auto text = reader.readString();
+
+            EventCalls events;
+            const auto eventsSize = reader.read<std::uint64_t>();
+            for (std::uint64_t i = 0; i < eventsSize; i++)
+            {
+                auto name = reader.readString();
+                events.emplace_back(std::move(name), reader.readString());
+            }
+
+            return { std::move(text), std::move(events) };
+        }
+
+        void writeSnapshotConditions(SnapshotWriter& writer, const Section::ConditionVector& conditions)
+        {
+            writer.write<std::uint64_t>(conditions.size());
+            for (const auto& condition : conditions)
+            {
+                writer.writeString(condition.name);
+                writer.write<std::uint64_t>(condition.arguments.size());
+                for (const auto& argument : condition.arguments)
+                    writer.writeString(argument);
+                writeSnapshotConditions(writer, condition.operands);
+            }
+        }
+
+        Section::ConditionVector readSnapshotConditions(SnapshotReader& reader)
+        {
+            Section::ConditionVector conditions;
+
+            const auto conditionsSize = reader.read<std::uint64_t>();
+            for (std::uint64_t i = 0; i < conditionsSize; i++)
+            {
+                auto& condition = conditions.emplace_back();
+                condition.name = reader.readString();
+
+                const auto argumentsSize = reader.read<std::uint64_t>();
+                for (std::uint64_t j = 0; j < argumentsSize; j++)
+                    condition.arguments.push_back(reader.readString());
+                condition.operands = readSnapshotConditions(reader);
+            }
+
+            return conditions;
+        }
+
+        /**
+         * @internal Names a predicate, the number of arguments it takes, and roughly how many log lookups it costs.
+         */
+        struct PredicateEntry
+        {
+            std::string_view name;
+            Section::Predicate predicate;
+            size_t arity;
+            size_t cost;
+        };
+
+        using enum Section::Predicate;
+
+        //! @internal The predicates shared by every Section, in the order of Section::Predicate.
+        constexpr std::array predicateTable{
+            PredicateEntry{ "expectEqual", ExpectEqual, 1, 1 },
+            PredicateEntry{ "expectLower", ExpectLower, 1, 1 },
+            PredicateEntry{ "expectLowerOrEqual", ExpectLowerOrEqual, 1, 1 },
+            PredicateEntry{ "expectHigher", ExpectHigher, 1, 1 },
+            PredicateEntry{ "expectHigherOrEqual", ExpectHigherOrEqual, 1, 1 },
+            PredicateEntry{ "expectNotEqual", ExpectNotEqual, 1, 1 },
+            PredicateEntry{ "triggeredSinceLatestSceneCall", TriggeredSinceLatestSceneCall, 2, 2 },
+            PredicateEntry{ "notTriggeredSinceLatestSceneCall", NotTriggeredSinceLatestSceneCall, 2, 2 },
+            PredicateEntry{ "triggeredBeforeLatestSceneCall", TriggeredBeforeLatestSceneCall, 2, 2 },
+            PredicateEntry{ "notTriggeredBeforeLatestSceneCall", NotTriggeredBeforeLatestSceneCall, 2, 2 },
+            PredicateEntry{ "triggeredBetweenLatestSceneCalls", TriggeredBetweenLatestSceneCalls, 2, 3 },
+            PredicateEntry{ "triggeredAtLeastSinceLatestSceneCall", TriggeredAtLeastSinceLatestSceneCall, 3, 3 },
+            PredicateEntry{ "triggeredFewerThanSinceLatestSceneCall", TriggeredFewerThanSinceLatestSceneCall, 3, 3 }
+        };
+
+        static_assert([] {
+            for (size_t i = 0; i < predicateTable.size(); i++)
+                if (static_cast<size_t>(predicateTable[i].predicate) != i)
+                    return false;
+            return true;
+        }(), "predicateTable must list predicates in the order of Section::Predicate.");
+
+        constexpr std::string_view andName = "and"; //!< @internal The name of "and" Conditions.
+        constexpr std::string_view orName = "or"; //!< @internal The name of "or" Conditions.
+        constexpr std::string_view notName = "not"; //!< @internal The name of "not" Conditions.
+
+        std::pair<std::vector<Line>, Section::ConditionVector> readSnapshotParts(SnapshotReader& reader)
+        {
+            std::pair<std::vector<Line>, Section::ConditionVector> parts;
+
+            const auto linesSize = reader.read<std::uint64_t>();
+            for (std::uint64_t i = 0; i < linesSize; i++)
+                parts.first.push_back(readSnapshotLine(reader));
+            parts.second = readSnapshotConditions(reader);
+
+            return parts;
+        }
+    }
+
     Section::Condition::Condition(std::string name, std::vector<std::string> arguments)
         : name(std::move(name)), arguments(std::move(arguments)) {}
 
+    Section::Condition Section::Condition::allOf(std::vector<Condition> operands)
+    {
+        Condition condition{ std::string(andName), {} };
+        condition.operands = std::move(operands);
+        return condition;
+    }
+
+    Section::Condition Section::Condition::anyOf(std::vector<Condition> operands)
+    {
+        Condition condition{ std::string(orName), {} };
+        condition.operands = std::move(operands);
+        return condition;
+    }
+
+    Section::Condition Section::Condition::negation(Condition operand)
+    {
+        Condition condition{ std::string(notName), {} };
+        condition.operands.push_back(std::move(operand));
+        return condition;
+    }
+
+    Section::Section(
+        std::vector<Line> lines, const Log& sceneLogRef, const EventLog& eventLogRef,
+        ConditionVector conditions
+    )
+        : _lines(std::make_shared<std::vector<Line> >(std::move(lines))), _cursor(0), _sceneLogRef(sceneLogRef),
+          _eventLogRef(eventLogRef), _conditions(std::move(conditions)),
+          _program(compileProgram(_conditions, _eventLogRef)),
+          _dirty(std::make_shared<bool>(true)), _state(false)
+    {
+        addDependencies();
+    }
+
     Section::Section(
         std::queue<Line> lines, const Log& sceneLogRef, const EventLog& eventLogRef,
         ConditionVector conditions
     )
-        : _lines(std::move(lines)), _isChecked(false), _sceneLogRef(sceneLogRef), _eventLogRef(eventLogRef),
-          _conditions(std::move(conditions)), _state(false),
-          _unaryPredicateMap({
-                                 { "expectEqual",
-                                   [this](const std::string& eventString) -> bool { return expectEqual(eventString); }},
-                                 { "expectLower",
-                                   [this](const std::string& eventString) -> bool { return expectLower(eventString); }},
-                                 { "expectLowerOrEqual", [this](const std::string& eventString) -> bool
-                                 {
-                                     return expectLowerOrEqual(eventString);
-                                 }},
-                                 { "expectHigher", [this](const std::string& eventString) -> bool
-                                 {
-                                     return expectHigher(eventString);
-                                 }},
-                                 { "expectHigherOrEqual", [this](const std::string& eventString) -> bool
-                                 {
-                                     return expectHigherOrEqual(eventString);
-                                 }},
-                                 { "expectNotEqual", [this](const std::string& eventString) -> bool
-                                 {
-                                     return expectNotEqual(eventString);
-                                 }}
-                             }),
-          _binaryPredicateMap({
-                                  { "triggeredSinceLatestSceneCall",
-                                    [this](const std::string& sceneName, const std::string& eventString) -> bool
-                                    {
-                                        return triggeredSinceLatestSceneCall(sceneName, eventString);
-                                    }},
-                                  { "notTriggeredSinceLatestSceneCall",
-                                    [this](const std::string& sceneName, const std::string& eventString) -> bool
-                                    {
-                                        return notTriggeredSinceLatestSceneCall(sceneName, eventString);
-                                    }},
-                                  { "triggeredBeforeLatestSceneCall",
-                                    [this](const std::string& sceneName, const std::string& eventString) -> bool
-                                    {
-                                        return triggeredBeforeLatestSceneCall(sceneName, eventString);
-                                    }},
-                                  { "notTriggeredBeforeLatestSceneCall",
-                                    [this](const std::string& sceneName, const std::string& eventString) -> bool
-                                    {
-                                        return notTriggeredBeforeLatestSceneCall(sceneName, eventString);
-                                    }},
-
-                              }) {}
+        : Section(std::vector<Line>(), sceneLogRef, eventLogRef, std::move(conditions))
+    {
+        _lines->reserve(lines.size());
+        for (; !lines.empty(); lines.pop())
+            _lines->push_back(std::move(lines.front()));
+    }
 
-    void Section::readLine(std::ostream& stream, EventMap& events) noexcept
+    Section::Section(SnapshotReader& reader, const Log& sceneLogRef, const EventLog& eventLogRef)
+        : Section(readSnapshotParts(reader), sceneLogRef, eventLogRef)
     {
-        _lines.front().readLine(stream, events);
-        _lines.pop();
+        *_dirty = reader.read<std::uint8_t>() == 0;
+        _state = reader.read<std::uint8_t>() != 0;
     }
 
-    bool Section::empty() const noexcept
+    Section::Section(const Section& other)
+        : _lines(other._lines), _cursor(other._cursor), _sceneLogRef(other._sceneLogRef),
+          _eventLogRef(other._eventLogRef), _conditions(other._conditions), _program(other._program),
+          _dirty(std::make_shared<bool>(*other._dirty)), _state(other._state)
     {
-        return _lines.empty();
+        addDependencies();
     }
 
-    Section::CheckResult Section::checkUnaryCondition(const Condition& condition) const noexcept
+    Section::Section(
+        std::pair<std::vector<Line>, ConditionVector> parts, const Log& sceneLogRef, const EventLog& eventLogRef
+    )
+        : Section(std::move(parts.first), sceneLogRef, eventLogRef, std::move(parts.second))
+    {}
+
+    void Section::writeSnapshot(SnapshotWriter& writer) const
     {
+        writer.write<std::uint64_t>(_lines->size() - _cursor);
+        for (auto line = _lines->begin() + _cursor; line != _lines->end(); ++line)
+            writeSnapshotLine(writer, *line);
 
-        auto refUnaryPredicate = _unaryPredicateMap.find(condition.name);
-        if (refUnaryPredicate == _unaryPredicateMap.end())
-            return CheckResult::InvalidCondition;
+        writeSnapshotConditions(writer, _conditions);
 
-        if (condition.arguments.size() != 1)
-            return CheckResult::InvalidSize;
+        writer.write<std::uint8_t>(!*_dirty);
+        writer.write<std::uint8_t>(_state);
+    }
 
-        if (!refUnaryPredicate->second(condition.arguments[0]))
-            return CheckResult::False;
-        return CheckResult::True;
+    void Section::readLine(std::ostream& stream, EventMap& events) noexcept
+    {
+        (*_lines)[_cursor].readLine(stream, events);
+        _cursor++;
     }
 
-    Section::CheckResult Section::checkBinaryCondition(const Condition& condition) const noexcept
+    void Section::link(const EventMap& events, const std::function<void(const Line&)>& onUnresolved)
     {
+        const auto unread = std::ranges::subrange(_lines->begin() + _cursor, _lines->end());
 
-        auto refBinaryPredicate = _binaryPredicateMap.find(condition.name);
-        if (refBinaryPredicate == _binaryPredicateMap.end())
-            return CheckResult::InvalidCondition;
+        // Copies of this Section may be reading the same Lines, so take a copy of them before linking any.
+        if (_lines.use_count() > 1 && !std::ranges::all_of(unread, &Line::linked))
+            _lines = std::make_shared<std::vector<Line> >(*_lines);
 
-        if (condition.arguments.size() != 2)
-            return CheckResult::InvalidSize;
+        for (auto line = _lines->begin() + _cursor; line != _lines->end(); ++line)
+        {
+            const bool found = line->linked()
+                ? std::ranges::none_of(line->events(), [](const EventCall& call) {
+                    return call.index == EventMap::noEvent;
+                })
+                : line->link(events);
+            if (!found)
+                onUnresolved(*line);
+        }
+    }
 
-        if (!refBinaryPredicate->second(condition.arguments[0], condition.arguments[1]))
-            return CheckResult::False;
+    std::vector<std::string> Section::eventNames() const
+    {
+        std::vector<std::string> names;
+        for (const auto& instruction : _program)
+        {
+            if (instruction.opcode == Predicate::And || instruction.opcode == Predicate::Or
+                || instruction.opcode == Predicate::Not)
+                continue;
 
-        return CheckResult::True;
+            const auto& name = _eventLogRef.eventName(instruction.event.id);
+            if (std::ranges::find(names, name) == names.end())
+                names.push_back(name);
+        }
+
+        return names;
     }
 
-    bool Section::isActive() const
+    void Section::skipLine() noexcept
     {
-        if (this->empty())
-            _state = false;
+        _cursor++;
+    }
+
+    const Line& Section::nextLine() const noexcept
+    {
+        return (*_lines)[_cursor];
+    }
 
-        if (_isChecked)
-            return _state;
+    void Section::rewind() noexcept
+    {
+        _cursor = 0;
+    }
+
+    std::shared_ptr<const std::vector<Line> > Section::lines() const noexcept
+    {
+        return _lines;
+    }
 
-        _isChecked = true;
+    bool Section::empty() const noexcept
+    {
+        return _cursor >= _lines->size();
+    }
 
-        _state = std::ranges::all_of(_conditions, [this](const auto& condition) -> bool
+    size_t Section::memoryUsage() const noexcept
+    {
+        size_t usage = sizeof(Section) + sizeof(bool) + _conditions.capacity() * sizeof(Condition)
+                       + _program.capacity() * sizeof(Instruction);
+        if (_lines.use_count() == 1)
         {
-            auto unaryCheck = checkUnaryCondition(condition);
-            auto binaryCheck = checkBinaryCondition(condition);
-            if (unaryCheck == CheckResult::True || binaryCheck == CheckResult::True)
-                return true;
-            if (unaryCheck == CheckResult::False || binaryCheck == CheckResult::False)
-                return false;
-            if (unaryCheck == CheckResult::InvalidSize || binaryCheck == CheckResult::InvalidSize)
-                throw std::invalid_argument{ condition.name + " contains an invalid number of arguments." };
+            usage += sizeof(std::vector<Line>) + _lines->capacity() * sizeof(Line);
+            for (const auto& line : *_lines)
+                usage += stringMemoryUsage(line.text());
+        }
+
+        return usage;
+    }
+
+    std::optional<std::pair<Section::Predicate, size_t> > Section::findPredicate(std::string_view name) noexcept
+    {
+        const auto found = std::ranges::find(predicateTable, name, &PredicateEntry::name);
+        if (found == predicateTable.end())
+            return {};
+
+        return std::make_pair(found->predicate, found->arity);
+    }
 
+    Section::Instruction Section::compile(const Condition& condition, const EventLog& eventLog)
+    {
+        const auto predicate = findPredicate(condition.name);
+        if (!predicate)
             throw std::out_of_range{ condition.name + " is not a valid condition." };
-        });
 
-        return _state;
+        const auto& [opcode, arity] = *predicate;
+        const auto& args = condition.arguments;
+        if (args.size() != arity)
+            throw std::invalid_argument{ condition.name + " contains an invalid number of arguments." };
+
+        // Unary predicates only take an eventString, the others take a Scene name first.
+        const auto& eventString = arity == 1 ? args[0] : args[1];
+        const auto split = splitEventString(eventString);
+        if (!split)
+            throw std::invalid_argument{ condition.name + " contains a malformed eventString: " + eventString };
+
+        size_t count = 0;
+        if (arity == 3)
+        {
+            const auto [end, error] = std::from_chars(args[2].data(), args[2].data() + args[2].size(), count);
+            if (error != std::errc() || end != args[2].data() + args[2].size())
+                throw std::invalid_argument{ condition.name + " contains a malformed count: " + args[2] };
+        }
+
+        return { opcode, EventKey{ eventLog.intern(split->first), split->second }, count, arity == 1 ? "" : args[0] };
     }
 
-#pragma region Condition functions
+    std::vector<Section::Instruction> Section::compileProgram(const ConditionVector& conditions,
+                                                              const EventLog& eventLog)
+    {
+        std::vector<Instruction> program;
+        compileOperator(Predicate::And, conditions, eventLog, program);
+        return program;
+    }
 
-    namespace
+    size_t Section::compileInto(const Condition& condition, const EventLog& eventLog, std::vector<Instruction>& program)
     {
-        [[nodiscard]] std::string getEventName(const std::string& eventString)
+        const bool isOperator = condition.name == andName || condition.name == orName || condition.name == notName;
+        if (!isOperator)
         {
-            return eventString.substr(0, eventString.find(','));
+            if (!condition.operands.empty())
+                throw std::invalid_argument{ condition.name + " can't take operands." };
+
+            program.push_back(compile(condition, eventLog));
+            return predicateTable[static_cast<size_t>(program.back().opcode)].cost;
         }
 
-        [[nodiscard]] int getEventReturn(const std::string& eventString)
+        if (!condition.arguments.empty())
+            throw std::invalid_argument{ condition.name + " can't take arguments." };
+        if (condition.name == notName && condition.operands.size() != 1)
+            throw std::invalid_argument{ condition.name + " takes exactly one operand." };
+
+        const auto opcode = condition.name == andName ? Predicate::And
+                            : condition.name == orName ? Predicate::Or : Predicate::Not;
+        return compileOperator(opcode, condition.operands, eventLog, program);
+    }
+
+    size_t Section::compileOperator(Predicate opcode, const ConditionVector& operands, const EventLog& eventLog,
+                                    std::vector<Instruction>& program)
+    {
+        // Compile every operand on its own, so they can be reordered to check the cheapest first.
+        std::vector<std::pair<size_t, std::vector<Instruction> > > compiled(operands.size());
+        for (size_t i = 0; i < operands.size(); i++)
+            compiled[i].first = compileInto(operands[i], eventLog, compiled[i].second);
+        std::ranges::stable_sort(compiled, {}, &std::pair<size_t, std::vector<Instruction> >::first);
+
+        const auto index = program.size();
+        program.push_back({ opcode, EventKey{}, 0, "" });
+
+        size_t cost = 0;
+        for (auto& [operandCost, instructions] : compiled)
         {
-            return std::stoi(eventString.substr(eventString.find(',') + 1));
+            cost += operandCost;
+            program.insert(program.end(), std::make_move_iterator(instructions.begin()),
+                           std::make_move_iterator(instructions.end()));
         }
+        program[index].length = program.size() - index;
+
+        return cost;
     }
-    bool Section::expectEqual(const std::string& eventString)
+
+    bool Section::evaluate(size_t index) const
     {
-        return !expectNotEqual(eventString);
+        const auto& instruction = _program[index];
+        switch (instruction.opcode)
+        {
+            case Predicate::And:
+            case Predicate::Or:
+            {
+                // Stop at the first operand that decides the result.
+                const bool isAnd = instruction.opcode == Predicate::And;
+                const auto end = index + instruction.length;
+                for (auto operand = index + 1; operand < end; operand += _program[operand].length)
+                    if (evaluate(operand) != isAnd)
+                        return !isAnd;
+
+                return isAnd;
+            }
+            case Predicate::Not:
+                return !evaluate(index + 1);
+            default:
+                try
+                {
+                    return check(instruction);
+                } catch (const DiscardedLogError& e)
+                {
+                    throw DiscardedLogError{ std::string(predicateTable[static_cast<size_t>(instruction.opcode)].name)
+                                             + " needs log records that were discarded: " + e.what() };
+                }
+        }
     }
 
-    bool Section::expectLower(const std::string& eventString)
+    bool Section::check(const Instruction& instruction) const
     {
-        auto name = getEventName(eventString);
-        auto expectedReturn = getEventReturn(eventString);
+        const auto& [event, count, scene] = std::tie(instruction.event, instruction.count, instruction.scene);
+        switch (instruction.opcode)
+        {
+            case Predicate::ExpectEqual:
+                return expectEqual(event);
+            case Predicate::ExpectLower:
+                return expectLower(event);
+            case Predicate::ExpectLowerOrEqual:
+                return expectLowerOrEqual(event);
+            case Predicate::ExpectHigher:
+                return expectHigher(event);
+            case Predicate::ExpectHigherOrEqual:
+                return expectHigherOrEqual(event);
+            case Predicate::ExpectNotEqual:
+                return expectNotEqual(event);
+            case Predicate::TriggeredSinceLatestSceneCall:
+                return triggeredSinceLatestSceneCall(scene, event);
+            case Predicate::NotTriggeredSinceLatestSceneCall:
+                return notTriggeredSinceLatestSceneCall(scene, event);
+            case Predicate::TriggeredBeforeLatestSceneCall:
+                return triggeredBeforeLatestSceneCall(scene, event);
+            case Predicate::NotTriggeredBeforeLatestSceneCall:
+                return notTriggeredBeforeLatestSceneCall(scene, event);
+            case Predicate::TriggeredBetweenLatestSceneCalls:
+                return triggeredBetweenLatestSceneCalls(scene, event);
+            case Predicate::TriggeredAtLeastSinceLatestSceneCall:
+                return triggeredAtLeastSinceLatestSceneCall(scene, event, count);
+            case Predicate::TriggeredFewerThanSinceLatestSceneCall:
+                return triggeredFewerThanSinceLatestSceneCall(scene, event, count);
+            case Predicate::And:
+            case Predicate::Or:
+            case Predicate::Not:
+                break;
+        }
 
-        auto results = _eventLogRef.findKeys(name);
-        return std::ranges::any_of(results, [expectedReturn](auto result) -> bool {
-           return getEventReturn(result) < expectedReturn;
-        });
+        return false;
     }
 
-    bool Section::expectLowerOrEqual(const std::string& eventString)
+    bool Section::isActive() const
     {
-        auto name = getEventName(eventString);
-        auto expectedReturn = getEventReturn(eventString);
+        if (this->empty())
+            return false;
 
-        auto results = _eventLogRef.findKeys(name);
-        return std::ranges::any_of(results, [expectedReturn](auto result) -> bool {
-           return getEventReturn(result) <= expectedReturn;
-        });
+        if (*_dirty)
+        {
+            _state = evaluate(0);
+            *_dirty = false;
+        }
+
+        return _state;
     }
 
-    bool Section::expectHigher(const std::string& eventString)
+    void Section::addDependencies() const
     {
-        auto name = getEventName(eventString);
-        auto expectedReturn = getEventReturn(eventString);
+        for (const auto& instruction : _program)
+        {
+            if (instruction.opcode == Predicate::And || instruction.opcode == Predicate::Or
+                || instruction.opcode == Predicate::Not)
+                continue;
+
+            _eventLogRef.addDependent(instruction.event.id, _dirty);
+            if (!instruction.scene.empty())
+                _sceneLogRef.addDependent(instruction.scene, _dirty);
+        }
+    }
 
-        auto results = _eventLogRef.findKeys(name);
-        return std::ranges::any_of(results, [expectedReturn](auto result) -> bool {
-            return getEventReturn(result) > expectedReturn;
-        });
+#pragma region Condition functions
+
+    bool Section::expectEqual(const EventKey& key) const
+    {
+        return !expectNotEqual(key);
     }
 
-    bool Section::expectHigherOrEqual(const std::string& eventString)
+    bool Section::expectLower(const EventKey& key) const
     {
-        auto name = getEventName(eventString);
-        auto expectedReturn = getEventReturn(eventString);
+        const auto& values = _eventLogRef.returnValues(key.id);
+        return !values.empty() && *values.begin() < key.returnValue;
+    }
 
-        auto results = _eventLogRef.findKeys(name);
-        return std::ranges::any_of(results, [expectedReturn](auto result) -> bool {
-            return getEventReturn(result) >= expectedReturn;
-        });
+    bool Section::expectLowerOrEqual(const EventKey& key) const
+    {
+        const auto& values = _eventLogRef.returnValues(key.id);
+        return !values.empty() && *values.begin() <= key.returnValue;
     }
 
-    bool Section::expectNotEqual(const std::string& eventString)
+    bool Section::expectHigher(const EventKey& key) const
     {
-        return _eventLogRef.query(eventString).empty();
+        const auto& values = _eventLogRef.returnValues(key.id);
+        return !values.empty() && *values.rbegin() > key.returnValue;
     }
 
-    bool Section::triggeredSinceLatestSceneCall(const std::string& sceneName, const std::string& eventString)
+    bool Section::expectHigherOrEqual(const EventKey& key) const
     {
-        auto sceneCalls = _sceneLogRef.query(sceneName);
-        auto eventCalls =  _eventLogRef.query(eventString);
-        if (eventCalls.empty() || sceneCalls.empty())
+        const auto& values = _eventLogRef.returnValues(key.id);
+        return !values.empty() && *values.rbegin() >= key.returnValue;
+    }
+
+    bool Section::expectNotEqual(const EventKey& key) const
+    {
+        return _eventLogRef.count(key) == 0;
+    }
+
+    bool Section::triggeredSinceLatestSceneCall(const std::string& sceneName, const EventKey& key) const
+    {
+        const auto sceneCall = _sceneLogRef.last(sceneName);
+        const auto eventCall = _eventLogRef.last(key);
+        if (!eventCall || !sceneCall)
             return false;
-        return eventCalls.back() >= sceneCalls.back();
+        return *eventCall >= *sceneCall;
     }
 
-    bool Section::notTriggeredSinceLatestSceneCall(const std::string& sceneName, const std::string& eventString)
+    bool Section::notTriggeredSinceLatestSceneCall(const std::string& sceneName, const EventKey& key) const
     {
-        auto sceneCalls = _sceneLogRef.query(sceneName);
-        auto eventCalls =  _eventLogRef.query(eventString);
-        if (eventCalls.empty() || sceneCalls.empty())
+        const auto sceneCall = _sceneLogRef.last(sceneName);
+        const auto eventCall = _eventLogRef.last(key);
+        if (!eventCall || !sceneCall)
             return true;
-        return eventCalls.back() < sceneCalls.back();
+        return *eventCall < *sceneCall;
     }
 
-    bool Section::triggeredBeforeLatestSceneCall(const std::string& sceneName, const std::string& eventString)
+    bool Section::triggeredBeforeLatestSceneCall(const std::string& sceneName, const EventKey& key) const
     {
-        auto sceneCalls = _sceneLogRef.query(sceneName);
-        auto eventCalls =  _eventLogRef.query(eventString);
-        if (eventCalls.empty())
+        const auto sceneCall = _sceneLogRef.last(sceneName);
+        const auto eventCall = _eventLogRef.last(key);
+        if (!eventCall)
             return false;
-        if (sceneCalls.empty())
+        if (!sceneCall)
             return true;
 
-        return eventCalls.back() < sceneCalls.back();
+        return *eventCall < *sceneCall;
     }
 
-    bool Section::notTriggeredBeforeLatestSceneCall(const std::string& sceneName, const std::string& eventString)
+    bool Section::notTriggeredBeforeLatestSceneCall(const std::string& sceneName, const EventKey& key) const
     {
-        auto sceneCalls = _sceneLogRef.query(sceneName);
-        auto eventCalls =  _eventLogRef.query(eventString);
-        if (eventCalls.empty())
+        const auto sceneCall = _sceneLogRef.last(sceneName);
+        const auto eventCall = _eventLogRef.last(key);
+        if (!eventCall)
             return true;
-        if (sceneCalls.empty())
+        if (!sceneCall)
+            return false;
+
+        return *eventCall >= *sceneCall;
+    }
+
+    bool Section::triggeredBetweenLatestSceneCalls(const std::string& sceneName, const EventKey& key) const
+    {
+        const auto previousSceneCall = _sceneLogRef.nthFromBack(sceneName, 1);
+        if (!previousSceneCall)
             return false;
 
-        return eventCalls.back() >= sceneCalls.back();
+        const auto eventCall = _eventLogRef.firstAtOrAfter(key, *previousSceneCall);
+        return eventCall && *eventCall < *_sceneLogRef.last(sceneName);
+    }
+
+    bool Section::triggeredAtLeastSinceLatestSceneCall(
+        const std::string& sceneName, const EventKey& key, size_t count) const
+    {
+        const auto sceneCall = _sceneLogRef.last(sceneName);
+        if (!sceneCall)
+            return false;
+
+        return _eventLogRef.countBetween(key, *sceneCall, SIZE_MAX) >= count;
+    }
+
+    bool Section::triggeredFewerThanSinceLatestSceneCall(
+        const std::string& sceneName, const EventKey& key, size_t count) const
+    {
+        const auto sceneCall = _sceneLogRef.last(sceneName);
+        const auto eventCalls = sceneCall ? _eventLogRef.countBetween(key, *sceneCall, SIZE_MAX) : 0;
+        return eventCalls < count;
     }
 
 #pragma endregion
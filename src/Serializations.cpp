@@ -6,19 +6,55 @@ namespace nlohmann
 {
     Scenes::Line adl_serializer<Scenes::Line>::from_json(const json& j)
     {
-        if (!j.contains("event"))
-            return Scenes::Line(j.value("text", ""));
-        else
-            return {j.value("text", ""), j.at("event"), j.value("arg", "")};
+        // A single Event may be written directly on the Line, followed by any number in its "events" array.
+        Scenes::EventCalls events;
+        if (j.contains("event") && !j.at("event").is_null())
+            events.emplace_back(j.at("event").get<std::string>(), j.value("arg", ""));
+        if (j.contains("events"))
+            for (const auto& event : j.at("events"))
+                events.emplace_back(event.at("event").get<std::string>(), event.value("arg", ""));
+
+        return {j.value("text", ""), std::move(events)};
     }
 
     void adl_serializer<Scenes::Line>::to_json(json& j, Scenes::Line line)
     {
-        j = json({"text", line.text()});
-        if (line.eventName().has_value())
-            j.push_back({"event", line.eventName().value()});
+        j = json{{"text", line.text()}};
+        if (line.events().size() == 1)
+        {
+            j["event"] = line.events()[0].name;
+            j["arg"] = line.events()[0].arg;
+        }
+        else if (!line.events().empty())
+        {
+            auto& events = j["events"] = json::array();
+            for (const auto& call : line.events())
+                events.push_back({{"event", call.name}, {"arg", call.arg}});
+        }
+        else
+            j["event"] = nullptr;
+    }
+
+    Scenes::Section::Condition adl_serializer<Scenes::Section::Condition>::from_json(const json& j)
+    {
+        using Condition = Scenes::Section::Condition;
+        if (j.contains("and"))
+            return Condition::allOf(j.at("and").get<std::vector<Condition> >());
+        if (j.contains("or"))
+            return Condition::anyOf(j.at("or").get<std::vector<Condition> >());
+        if (j.contains("not"))
+            return Condition::negation(j.at("not").get<Condition>());
+
+        return {j.at("name").get<std::string>(), j.at("arguments").get<std::vector<std::string> >()};
+    }
+
+    void adl_serializer<Scenes::Section::Condition>::to_json(json& j, const Scenes::Section::Condition& condition)
+    {
+        if (condition.name == "not" && condition.operands.size() == 1)
+            j = json{{"not", condition.operands.front()}};
+        else if ((condition.name == "and" || condition.name == "or") && condition.arguments.empty())
+            j = json{{condition.name, condition.operands}};
         else
-            j.push_back({"event", nullptr});
-        j.push_back({"arg", line.eventArg()});
+            j = json{{"name", condition.name}, {"arguments", condition.arguments}};
     }
-}
\ No newline at end of file
+}
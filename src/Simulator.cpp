@@ -0,0 +1,303 @@
+#include "Simulator.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+#include "Pacing.hpp"
+#include "Serializations.hpp"
+#include "pch.h"
+
+namespace Scenes
+{
+    namespace
+    {
+        /**
+         * @internal Thrown to end a session that read more Lines than it may.
+         */
+        struct LineLimitReached
+        {};
+
+        /**
+         * @internal Reads Lines as fast as possible, ending the session once it reaches its limit.
+         */
+        class LimitedPacing final : public Pacing
+        {
+        public:
+            explicit LimitedPacing(size_t limit) noexcept
+                : _limit(limit), _lines(0)
+            {}
+
+            void lineRead(const Line&) override
+            {
+                _lines++;
+            }
+
+            bool ready(Clock::time_point) override
+            {
+                return true;
+            }
+
+            std::optional<Clock::time_point> nextDeadline() override
+            {
+                return Clock::time_point::min();
+            }
+
+            void awaitNextLine() override
+            {
+                if (_lines >= _limit)
+                    throw LineLimitReached{};
+            }
+
+        private:
+            const size_t _limit;
+            size_t _lines;
+        };
+
+        /**
+         * @internal A queue of task indices that its worker takes from the back of and others steal from the front of.
+         */
+        struct TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<size_t> tasks;
+        };
+
+        std::optional<size_t> nextTask(std::vector<TaskQueue>& queues, size_t worker)
+        {
+            // Taking from the back of its own queue and stealing from the front of the others keeps thieves away from
+            // the tasks a worker is about to take.
+            for (size_t offset = 0; offset < queues.size(); offset++)
+            {
+                auto& queue = queues[(worker + offset) % queues.size()];
+                std::lock_guard lock(queue.mutex);
+                if (queue.tasks.empty())
+                    continue;
+
+                const auto task = offset == 0 ? queue.tasks.back() : queue.tasks.front();
+                if (offset == 0)
+                    queue.tasks.pop_back();
+                else
+                    queue.tasks.pop_front();
+                return task;
+            }
+
+            return {};
+        }
+
+        /**
+         * @internal Runs every task on its own thread set, as run(worker, task). Tasks must not throw.
+         */
+        template<class Function>
+        void runStealing(size_t tasks, size_t workers, const Function& run)
+        {
+            std::vector<TaskQueue> queues(workers);
+            for (size_t task = 0; task < tasks; task++)
+                queues[task % workers].tasks.push_back(task);
+
+            const auto work = [&queues, &run](size_t worker)
+            {
+                while (const auto task = nextTask(queues, worker))
+                    run(worker, *task);
+            };
+
+            // The calling thread is the first worker.
+            std::vector<std::thread> threads;
+            threads.reserve(workers - 1);
+            try
+            {
+                for (size_t worker = 1; worker < workers; worker++)
+                    threads.emplace_back(work, worker);
+            } catch (...)
+            {
+                work(0);
+                for (auto& thread : threads)
+                    thread.join();
+                throw;
+            }
+
+            work(0);
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        void merge(SimulationReport& into, const SimulationReport& from)
+        {
+            into.sessions += from.sessions;
+            into.finished += from.finished;
+            into.stopped += from.stopped;
+            into.failed += from.failed;
+
+            for (const auto& [scene, count] : from.scenes)
+                into.scenes[scene] += count;
+            for (const auto& [section, count] : from.sections)
+                into.sections[section] += count;
+            for (const auto& [event, returns] : from.eventReturns)
+                for (const auto& [value, count] : returns)
+                    into.eventReturns[event][value] += count;
+            for (const auto& [scene, count] : from.endings)
+                into.endings[scene] += count;
+        }
+    }
+
+    ScriptedResponder::ScriptedResponder(std::unordered_map<std::string, int> answers, int fallback)
+        : _answers(std::move(answers)), _fallback(fallback)
+    {}
+
+    int ScriptedResponder::respond(const std::string& event, const std::string&, std::mt19937_64&) const
+    {
+        const auto answer = _answers.find(event);
+        return answer == _answers.end() ? _fallback : answer->second;
+    }
+
+    RandomResponder::RandomResponder(std::unordered_map<std::string, std::vector<int> > choices,
+                                     std::vector<int> fallback)
+        : _choices(std::move(choices)), _fallback(fallback.empty() ? std::vector<int>{ 0 } : std::move(fallback))
+    {}
+
+    int RandomResponder::respond(const std::string& event, const std::string&, std::mt19937_64& random) const
+    {
+        const auto choices = _choices.find(event);
+        const auto& values = choices == _choices.end() || choices->second.empty() ? _fallback : choices->second;
+
+        std::uniform_int_distribution<size_t> pick(0, values.size() - 1);
+        return values[pick(random)];
+    }
+
+    Simulator::Simulator(std::filesystem::path sceneLoc, std::string startScene,
+                         std::shared_ptr<const Responder> responder)
+        : _sceneLoc(std::move(sceneLoc)), _startScene(std::move(startScene)), _responder(std::move(responder))
+    {
+        std::set<std::string> eventNames;
+        for (const auto& entry : std::filesystem::directory_iterator(_sceneLoc))
+        {
+            if (!entry.is_regular_file() || entry.path().extension() != ".json")
+                continue;
+
+            std::ifstream file{ entry.path() };
+            const auto sceneJson = nlohmann::json::parse(file);
+            if (!sceneJson.is_array())
+                continue;
+
+            _sceneSections[entry.path().stem().string()] = sceneJson.size();
+            for (const auto& section : sceneJson)
+                for (const auto& lineJson : section.value("lines", nlohmann::json::array()))
+                {
+                    const auto line = lineJson.get<Line>();
+                    for (const auto& call : line.events())
+                        eventNames.insert(call.name);
+                }
+        }
+
+        _eventNames.assign(eventNames.begin(), eventNames.end());
+    }
+
+    SimulationReport Simulator::run(const SimulationOptions& options) const
+    {
+        const auto hardwareThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+        const auto workers = std::clamp<size_t>(options.workers ? options.workers : hardwareThreads, 1,
+                                                std::max<size_t>(options.sessions, 1));
+
+        // Every worker adds to its own report, so sessions never wait on each other.
+        std::vector<SimulationReport> partial(workers);
+        runStealing(options.sessions, workers, [&](size_t worker, size_t session) {
+            runSession(session, options, partial[worker]);
+        });
+
+        SimulationReport report;
+        for (const auto& workerReport : partial)
+            merge(report, workerReport);
+
+        for (const auto& [scene, sections] : _sceneSections)
+        {
+            if (!report.scenes.contains(scene))
+                report.unvisitedScenes.push_back(scene);
+
+            for (size_t section = 0; section < sections; section++)
+                if (!report.sections.contains({ scene, section }))
+                    report.unreadSections.emplace_back(scene, section);
+        }
+
+        return report;
+    }
+
+    const std::vector<std::string>& Simulator::eventNames() const noexcept
+    {
+        return _eventNames;
+    }
+
+    void Simulator::runSession(size_t index, const SimulationOptions& options, SimulationReport& report) const
+    {
+        report.sessions++;
+
+        std::seed_seq seed{ static_cast<std::uint32_t>(options.seed), static_cast<std::uint32_t>(options.seed >> 32),
+                            static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32) };
+        std::mt19937_64 random{ seed };
+
+        std::set<std::pair<std::string, size_t> > sections;
+        std::map<std::string, std::map<int, size_t> > eventReturns;
+        std::string lastScene;
+        bool finished = false;
+
+        try
+        {
+            Reader reader{ _sceneLoc.string(), _sceneLoc.string(), _startScene };
+            reader.setPacing(std::make_shared<LimitedPacing>(options.lineLimit));
+            reader.setPrefetching(false); // Sessions already keep every worker busy
+            reader.setSectionObserver([&](const std::string& scene, size_t section) {
+                sections.emplace(scene, section);
+                lastScene = scene;
+            });
+
+            if (options.setup)
+                options.setup(reader);
+            for (const auto& name : _eventNames)
+            {
+                // Events built into the Reader or added by setup keep their own behaviour.
+                if (reader.hasEvent(name))
+                    continue;
+
+                reader.addEvent(name, [&, name](const std::string& argument) -> int {
+                    const auto value = _responder->respond(name, argument, random);
+                    eventReturns[name][value]++;
+                    return value;
+                });
+            }
+
+            std::ostream discarded{ nullptr };
+            try
+            {
+                reader.readFrom(_startScene, discarded);
+                finished = true;
+            } catch (const LineLimitReached&)
+            {
+                report.stopped++;
+            }
+
+            for (const auto& scene : _sceneSections | std::views::keys)
+                if (reader.sceneLog().count(scene) > 0)
+                    report.scenes[scene]++;
+        } catch (const std::exception&)
+        {
+            report.failed++;
+        }
+
+        // Coverage of failed sessions is kept too, as it shows how far they got.
+        for (const auto& section : sections)
+            report.sections[section]++;
+        for (const auto& [event, returns] : eventReturns)
+            for (const auto& [value, count] : returns)
+                report.eventReturns[event][value] += count;
+        if (finished)
+        {
+            report.finished++;
+            report.endings[lastScene]++;
+        }
+    }
+} // Scenes
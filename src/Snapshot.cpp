@@ -0,0 +1,222 @@
+#include "Snapshot.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "pch.h"
+
+namespace Scenes
+{
+    namespace
+    {
+        constexpr std::uint8_t nativeByteOrder = std::endian::native == std::endian::little ? 0 : 1;
+    }
+
+#pragma region SnapshotWriter
+    void SnapshotWriter::writeHeader()
+    {
+        write(snapshotMagic);
+        write(snapshotVersion);
+        write(nativeByteOrder);
+        write<std::uint8_t>(sizeof(size_t));
+    }
+
+    void SnapshotWriter::writeString(const std::string& value)
+    {
+        writeArray(std::span<const char>(value));
+    }
+
+    void SnapshotWriter::saveTo(const std::filesystem::path& path) const
+    {
+        // Written beside the snapshot and renamed over it once on disk, so a crash leaves the old snapshot or the new.
+        auto temporary = path;
+        temporary += ".tmp";
+
+        if (!writeFile(temporary))
+        {
+            std::error_code error;
+            std::filesystem::remove(temporary, error);
+            throw SnapshotError{ "Unable to write snapshot " + path.string() + "." };
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error)
+        {
+            std::filesystem::remove(temporary, error);
+            throw SnapshotError{ "Unable to replace snapshot " + path.string() + "." };
+        }
+    }
+
+#ifdef _WIN32
+    bool SnapshotWriter::writeFile(const std::filesystem::path& path) const noexcept
+    {
+        const HANDLE file = CreateFileW(path.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL,
+                                        nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        bool written = true;
+        for (size_t offset = 0; written && offset < _data.size();)
+        {
+            DWORD count = 0;
+            const auto size = static_cast<DWORD>(std::min<size_t>(_data.size() - offset, MAXDWORD));
+            written = WriteFile(file, _data.data() + offset, size, &count, nullptr) && count > 0;
+            offset += count;
+        }
+        written = written && FlushFileBuffers(file);
+        return CloseHandle(file) && written;
+    }
+#else
+    bool SnapshotWriter::writeFile(const std::filesystem::path& path) const noexcept
+    {
+        const int file = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (file < 0)
+            return false;
+
+        bool written = true;
+        for (size_t offset = 0; written && offset < _data.size();)
+        {
+            const auto count = ::write(file, _data.data() + offset, _data.size() - offset);
+            if (count < 0 && errno == EINTR)
+                continue;
+            written = count > 0;
+            offset += written ? static_cast<size_t>(count) : 0;
+        }
+        written = written && fsync(file) == 0;
+        return close(file) == 0 && written;
+    }
+#endif
+
+    const std::vector<char>& SnapshotWriter::data() const noexcept
+    {
+        return _data;
+    }
+#pragma endregion
+
+#pragma region SnapshotReader
+    SnapshotReader::SnapshotReader(std::span<const char> data) noexcept
+        : _data(data), _offset(0)
+    {}
+
+    void SnapshotReader::readHeader()
+    {
+        if (read<std::uint32_t>() != snapshotMagic)
+            throw SnapshotError{ "File is not a Scenes snapshot." };
+        if (const auto version = read<std::uint32_t>(); version != snapshotVersion)
+            throw SnapshotError{ "Unsupported snapshot version " + std::to_string(version) + "." };
+        if (read<std::uint8_t>() != nativeByteOrder || read<std::uint8_t>() != sizeof(size_t))
+            throw SnapshotError{ "Snapshot was written on an incompatible platform." };
+    }
+
+    std::string SnapshotReader::readString()
+    {
+        const auto size = read<std::uint64_t>();
+        if (size > _data.size() - _offset)
+            throw SnapshotError{ "Snapshot is truncated." };
+
+        return { take(size), size };
+    }
+
+    bool SnapshotReader::atEnd() const noexcept
+    {
+        return _offset == _data.size();
+    }
+
+    const char* SnapshotReader::take(size_t size)
+    {
+        if (size > _data.size() - _offset)
+            throw SnapshotError{ "Snapshot is truncated." };
+
+        const char* bytes = _data.data() + _offset;
+        _offset += size;
+        return bytes;
+    }
+#pragma endregion
+
+#pragma region MappedFile
+#ifdef _WIN32
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : _data(nullptr), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(nullptr)
+    {
+        _file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_file == INVALID_HANDLE_VALUE)
+            throw SnapshotError{ "Unable to open snapshot " + path.string() + "." };
+
+        LARGE_INTEGER size;
+        GetFileSizeEx(_file, &size);
+        _size = static_cast<size_t>(size.QuadPart);
+        if (_size == 0)
+            return;
+
+        _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping)
+            _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!_data)
+        {
+            release();
+            throw SnapshotError{ "Unable to map snapshot " + path.string() + "." };
+        }
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (_data)
+            UnmapViewOfFile(_data);
+        if (_mapping)
+            CloseHandle(_mapping);
+        if (_file != INVALID_HANDLE_VALUE)
+            CloseHandle(_file);
+    }
+#else
+    MappedFile::MappedFile(const std::filesystem::path& path)
+        : _data(nullptr), _size(0)
+    {
+        const int file = open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            throw SnapshotError{ "Unable to open snapshot " + path.string() + "." };
+
+        struct stat status{};
+        if (fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            _size = static_cast<size_t>(status.st_size);
+            void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+            _data = mapping == MAP_FAILED ? nullptr : static_cast<const char*>(mapping);
+        }
+        close(file);
+
+        if (_size > 0 && !_data)
+            throw SnapshotError{ "Unable to map snapshot " + path.string() + "." };
+    }
+
+    void MappedFile::release() noexcept
+    {
+        if (_data)
+            munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+
+    MappedFile::~MappedFile()
+    {
+        release();
+    }
+
+    std::span<const char> MappedFile::data() const noexcept
+    {
+        return { _data, _size };
+    }
+#pragma endregion
+} // Scenes
@@ -0,0 +1,64 @@
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Scenes/AppendQueue.hpp"
+
+using namespace Scenes;
+
+TEST(AppendQueueTests, DrainsInPushOrder)
+{
+	AppendQueue<std::string> queue;
+	EXPECT_TRUE(queue.empty());
+
+	queue.push("First");
+	queue.push("Second");
+	queue.push("Third");
+	EXPECT_FALSE(queue.empty());
+
+	std::vector<std::string> drained;
+	EXPECT_EQ(3u, queue.drain([&](std::string&& value) { drained.push_back(std::move(value)); }));
+	EXPECT_EQ((std::vector<std::string>{ "First", "Second", "Third" }), drained);
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(0u, queue.drain([](std::string&&) { FAIL(); }));
+}
+
+TEST(AppendQueueTests, ConcurrentPushes)
+{
+	constexpr int threads = 8;
+	constexpr int pushes = 10000;
+
+	AppendQueue<std::pair<int, int> > queue;
+	std::vector<int> nextExpected(threads, 0);
+	size_t drained = 0;
+
+	std::vector<std::thread> producers;
+	for (int thread = 0; thread < threads; thread++)
+		producers.emplace_back([&queue, thread] {
+			for (int i = 0; i < pushes; i++)
+				queue.push({ thread, i });
+		});
+
+	// Drain while producers push; every producer's values must still arrive in its own order.
+	const auto consume = [&](std::pair<int, int>&& value) {
+		EXPECT_EQ(nextExpected[value.first]++, value.second);
+	};
+	while (drained < threads * pushes)
+		drained += queue.drain(consume);
+
+	for (auto& producer : producers)
+		producer.join();
+	EXPECT_EQ(static_cast<size_t>(threads * pushes), drained);
+	EXPECT_TRUE(queue.empty());
+}
+
+TEST(AppendQueueTests, IsMoveConstructible)
+{
+	AppendQueue<int> queue;
+	queue.push(1);
+
+	AppendQueue<int> moved(std::move(queue));
+	EXPECT_TRUE(queue.empty());
+	EXPECT_EQ(1u, moved.drain([](int value) { EXPECT_EQ(1, value); }));
+}
@@ -0,0 +1,57 @@
+#include <string>
+#include <variant>
+#include <gtest/gtest.h>
+
+#include "Scenes/EventArgument.hpp"
+
+using namespace Scenes;
+
+namespace
+{
+    struct Attack
+    {
+        int power;
+        std::string element;
+    };
+}
+
+TEST(EventArgumentTests, HoldsBuiltinTypes)
+{
+    EXPECT_TRUE(EventArgument().holds<std::string>());
+    EXPECT_EQ("", EventArgument().get<std::string>());
+
+    const EventArgument text{ "arrow" };
+    EXPECT_TRUE(text.holds<std::string>());
+    EXPECT_FALSE(text.holds<int>());
+    EXPECT_EQ("arrow", text.get<std::string>());
+    EXPECT_THROW((void)text.get<int>(), std::bad_variant_access);
+
+    EXPECT_EQ(4, EventArgument(4).get<int>());
+    EXPECT_DOUBLE_EQ(0.5, EventArgument(0.5).get<double>());
+    EXPECT_TRUE(EventArgument::make<int>(7).holds<int>());
+}
+
+TEST(EventArgumentTests, HoldsCustomTypes)
+{
+    const auto argument = EventArgument::make(Attack{ 12, "fire" });
+    ASSERT_TRUE(argument.holds<Attack>());
+    EXPECT_FALSE(argument.holds<std::string>());
+    EXPECT_EQ(12, argument.get<Attack>().power);
+    EXPECT_EQ("fire", argument.get<Attack>().element);
+    EXPECT_THROW((void)argument.get<int>(), std::bad_variant_access);
+
+    const EventArgument copy = argument; // Copies share the parsed value
+    EXPECT_EQ(&argument.get<Attack>(), &copy.get<Attack>());
+}
+
+TEST(EventArgumentTests, ParsesWholeNumbers)
+{
+    EXPECT_EQ(-15, parseArgument<int>("-15"));
+    EXPECT_DOUBLE_EQ(2.25, parseArgument<double>("2.25"));
+    EXPECT_EQ("10 gold", parseArgument<std::string>("10 gold"));
+
+    EXPECT_THROW((void)parseArgument<int>("10 gold"), EventArgumentError);
+    EXPECT_THROW((void)parseArgument<int>(""), EventArgumentError);
+    EXPECT_THROW((void)parseArgument<int>("99999999999"), EventArgumentError);
+    EXPECT_THROW((void)parseArgument<double>("fast"), EventArgumentError);
+}
@@ -0,0 +1,69 @@
+#include <array>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <gtest/gtest.h>
+
+#include "Scenes/EventFunction.hpp"
+
+using namespace Scenes;
+
+TEST(EventFunctionTests, CallsStoredCallable)
+{
+	int calls = 0;
+	EventFunction<int(std::string)> function{ [&calls](const std::string& s) { calls++; return std::stoi(s); } };
+
+	EXPECT_TRUE(function);
+	EXPECT_EQ(12, function("12"));
+	EXPECT_EQ(1, calls);
+}
+
+TEST(EventFunctionTests, StoresMoveOnlyCallables)
+{
+	EventFunction<int()> function{ [value = std::make_unique<int>(5)] { return *value; } };
+	EXPECT_EQ(5, function());
+
+	EventFunction<int()> moved{ std::move(function) };
+	EXPECT_FALSE(function);
+	EXPECT_EQ(5, moved());
+}
+
+TEST(EventFunctionTests, StoresLargeCallablesOnHeap)
+{
+	std::array<int, 64> values{};
+	values[63] = 7;
+
+	EventFunction<int()> function{ [values] { return values[63]; } };
+	EventFunction<int()> other;
+	other = std::move(function);
+	EXPECT_EQ(7, other());
+}
+
+TEST(EventFunctionTests, DestroysCallableOnce)
+{
+	const auto counter = std::make_shared<int>(0);
+	{
+		EventFunction<int()> function{ [counter] { return *counter; } };
+		EventFunction<int()> moved{ std::move(function) };
+		EXPECT_EQ(2, counter.use_count());
+
+		moved = EventFunction<int()>{ [] { return 0; } };
+		EXPECT_EQ(1, counter.use_count());
+	}
+	EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(EventFunctionTests, TargetType)
+{
+	const auto lambda = [](int a) { return a; };
+	EXPECT_EQ(typeid(void), EventFunction<int(int)>().targetType());
+	EXPECT_EQ(typeid(lambda), EventFunction<int(int)>(lambda).targetType());
+	EXPECT_EQ(typeid(std::function<int(int)>), EventFunction<int(int)>(std::function<int(int)>(lambda)).targetType());
+}
+
+TEST(EventFunctionTests, IsMoveOnly)
+{
+	EXPECT_TRUE(std::is_nothrow_move_constructible_v<EventFunction<int(std::string)> >);
+	EXPECT_FALSE(std::is_copy_constructible_v<EventFunction<int(std::string)> >);
+}
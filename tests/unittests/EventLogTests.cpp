@@ -1,9 +1,17 @@
 #include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
 #include <ranges>
+#include <thread>
 #include <type_traits>
+#include <vector>
 #include <gtest/gtest.h>
 
+#include "Scenes/Event.hpp"
 #include "Scenes/EventLog.hpp"
+#include "Scenes/Journal.hpp"
 
 using namespace Scenes;
 
@@ -64,7 +72,215 @@ TEST_F(EventLogTests, FindEventCorrectly)
 	EXPECT_EQ(std::vector<Scenes::LogNameType>{}, log.findKeys("NonExistent"));
 }
 
+TEST_F(EventLogTests, InternIsStable)
+{
+	const EventId first = log.intern("Event");
+	const EventId second = log.intern("Other Event");
+
+	EXPECT_NE(first, second);
+	EXPECT_EQ(first, log.intern("Event"));
+	EXPECT_EQ(second, log.findId("Other Event"));
+	EXPECT_EQ("Event", log.eventName(first));
+	EXPECT_EQ(std::nullopt, log.findId("NonExistent"));
+	EXPECT_TRUE(log.empty()); // Interning doesn't log anything
+}
+
+TEST_F(EventLogTests, KeyAndEventStringShareRecords)
+{
+	const EventKey key{ log.intern("Event"), 10 };
+	LogResultType expected;
+
+	log.addLog(key);
+	expected.push_back(linesRead);
+	linesRead++;
+	log.addLog("Event,10");
+	expected.push_back(linesRead);
+
+	EXPECT_EQ(expected, log.query(key));
+	EXPECT_EQ(expected, log.query("Event,10"));
+	EXPECT_EQ(key, log.findKey("Event,10"));
+	EXPECT_EQ(std::vector<LogNameType>{ "Event,10" }, log.findKeys("Event"));
+}
+
+TEST_F(EventLogTests, SplitEventStringOnlyAcceptsCanonicalStrings)
+{
+	EXPECT_EQ(std::make_pair(std::string("Event"), -4), splitEventString("Event,-4"));
+	EXPECT_EQ(std::make_pair(std::string(""), 0), splitEventString(",0"));
+	EXPECT_EQ(std::nullopt, splitEventString("Event, 10"));
+	EXPECT_EQ(std::nullopt, splitEventString("Event,010"));
+	EXPECT_EQ(std::nullopt, splitEventString("Event,-0"));
+	EXPECT_EQ(std::nullopt, splitEventString("Event,"));
+	EXPECT_EQ(std::nullopt, splitEventString("Event"));
+}
+
+TEST_F(EventLogTests, ReturnValueIndex)
+{
+	EXPECT_EQ(std::nullopt, log.lowestReturn("Event"));
+	EXPECT_FALSE(log.anyReturnBetween("Event", 0, 100));
+
+	log.addLog(createEventString("Event", 7));
+	log.addLog(createEventString("Event", -3));
+	log.addLog(createEventString("Event", 7));
+	log.addLog(createEventString("Event", 40));
+	log.addLog(createEventString("Event2", 100));
+
+	EXPECT_EQ((std::set<int>{ -3, 7, 40 }), log.returnValues(log.intern("Event")));
+	EXPECT_EQ(-3, log.lowestReturn("Event"));
+	EXPECT_EQ(40, log.highestReturn("Event"));
+	EXPECT_TRUE(log.anyReturnBetween("Event", 5, 10));
+	EXPECT_FALSE(log.anyReturnBetween("Event", 8, 39));
+	EXPECT_FALSE(log.anyReturnBetween("Event", 50, 200));
+}
+
+TEST_F(EventLogTests, ViewByKeyAndEventString)
+{
+	const EventKey key{ log.intern("Event"), 2 };
+
+	log.addLog(key);
+	linesRead += 2;
+	log.addLog(key);
+
+	EXPECT_TRUE(std::ranges::equal(LogResultType{ 0, 2 }, log.view(key)));
+	EXPECT_TRUE(std::ranges::equal(log.view(key), log.view("Event,2")));
+	EXPECT_EQ(0, log.first(key));
+	EXPECT_EQ(2, log.last("Event,2"));
+	EXPECT_EQ(2, log.count(key));
+	EXPECT_EQ(0, log.count("Event,3"));
+}
+
+TEST_F(EventLogTests, ConcurrentEvents)
+{
+	Event<int> event([](int value) { return value % 3; }, "Worker Event", log);
+	log.setConcurrent(true);
+	linesRead = 4;
+
+	std::vector<std::thread> workers;
+	for (int thread = 0; thread < 4; thread++)
+		workers.emplace_back([&event] {
+			for (int i = 0; i < 300; i++)
+				event(i);
+		});
+	for (auto& worker : workers)
+		worker.join();
+
+	EXPECT_TRUE(log.empty());
+	log.synchronize();
+
+	for (int returnValue = 0; returnValue < 3; returnValue++)
+	{
+		EXPECT_EQ(400, log.count(EventKey{ event.eventKey().id, returnValue }));
+		EXPECT_EQ(4, log.last("Worker Event," + std::to_string(returnValue)));
+	}
+	EXPECT_EQ(3, log.findKeys("Worker Event").size());
+}
+
+TEST_F(EventLogTests, AppliesConcurrentAppendsInOrder)
+{
+	const auto path = std::filesystem::temp_directory_path()
+		/ ("EventLogTests.AppliesConcurrentAppendsInOrder." + std::to_string(std::random_device{}()) + ".bin");
+	std::filesystem::remove(path);
+	const auto id = log.intern("Worker Event");
+	log.setConcurrent(true);
+
+	std::vector<std::thread> workers;
+	for (int thread = 0; thread < 4; thread++)
+		workers.emplace_back([this, id, thread] {
+			for (int i = 0; i < 100; i++)
+			{
+				log.addLog("Worker " + std::to_string(thread));
+				log.addLog(EventKey{ id, thread });
+			}
+		});
+	for (auto& worker : workers)
+		worker.join();
+
+	{
+		Journal journal{ path, { JournalSync::Never } };
+		log.setJournal(&journal, 0);
+		log.synchronize();
+		log.setJournal(nullptr, 0);
+	}
+
+	// Appends from different threads interleave, but each thread's names and keys stay in the order it made them.
+	std::vector<JournalEntry::Kind> last(4, JournalEntry::Kind::Event);
+	size_t replayed = 0;
+	(void)Journal::replay(path, [&](const JournalEntry& entry)
+	{
+		const auto thread = entry.kind == JournalEntry::Kind::Event ? entry.key.returnValue : entry.name.back() - '0';
+		EXPECT_NE(last[thread], entry.kind);
+		last[thread] = entry.kind;
+		replayed++;
+	});
+	std::filesystem::remove(path);
+
+	EXPECT_EQ(800u, replayed);
+}
+
+TEST_F(EventLogTests, AddAtEarlierLine)
+{
+	const EventKey key{ log.intern("Slow Event"), 1 };
+	linesRead = 5;
+	log.addLog(key, 2);
+	log.addLog(key, 4);
+	linesRead = 9;
+	log.addLog(key);
+	log.addLog(key, 3); // Raised to the last line of the record, so records stay sorted
+
+	EXPECT_EQ((LogResultType{ 2, 4, 9, 9 }), log.query(key));
+}
+
 TEST_F(EventLogTests, IsMoveConstructible)
 {
     EXPECT_TRUE(std::is_move_constructible<EventLog>::value);
-}
\ No newline at end of file
+}
+TEST_F(EventLogTests, RaisesDependentsOfAnyReturnValue)
+{
+	const auto door = std::make_shared<bool>(false);
+	const auto scene = std::make_shared<bool>(false);
+	log.addDependent(log.intern("Door"), door);
+	log.addDependent("Cellar", scene);
+
+	log.addLog(EventKey{ log.intern("Window"), 1 });
+	EXPECT_FALSE(*door);
+
+	log.addLog(EventKey{ log.intern("Door"), 3 });
+	EXPECT_TRUE(*door);
+
+	*door = false;
+	log.addLog(createEventString("Door", 7)); // eventStrings raise the dependents of their Event
+	EXPECT_TRUE(*door);
+	EXPECT_FALSE(*scene);
+
+	log.addLog("Cellar");
+	EXPECT_TRUE(*scene);
+}
+
+TEST_F(EventLogTests, AddsBatchesGroupedByKey)
+{
+	const auto door = std::make_shared<bool>(false);
+	const auto window = std::make_shared<bool>(false);
+	log.addDependent(log.intern("Door"), door);
+	log.addDependent(log.intern("Window"), window);
+
+	linesRead = 4;
+	const std::vector<EventKey> keys{
+		{ log.intern("Window"), 1 }, { log.intern("Door"), 2 }, { log.intern("Window"), 1 }, { log.intern("Door"), -1 }
+	};
+	log.addLogs(keys);
+
+	EXPECT_EQ((LogResultType{ 4, 4 }), log.query(EventKey{ log.intern("Window"), 1 }));
+	EXPECT_EQ(1u, log.count(EventKey{ log.intern("Door"), 2 }));
+	EXPECT_EQ(1u, log.count(EventKey{ log.intern("Door"), -1 }));
+	EXPECT_TRUE(*door);
+	EXPECT_TRUE(*window);
+}
+
+TEST_F(EventLogTests, MemoryUsageCountsEventRecords)
+{
+	const auto empty = log.memoryUsage();
+	EXPECT_GE(empty, sizeof(EventLog));
+
+	log.addLog(EventKey{ log.intern("Door"), 1 });
+	log.addLog(EventKey{ log.intern("Door"), 2 });
+	EXPECT_GT(log.memoryUsage(), empty + 2 * sizeof(LogRecord));
+}
@@ -0,0 +1,87 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <gtest/gtest.h>
+
+#include "Scenes/EventMap.hpp"
+#include "Scenes/Line.hpp"
+
+using namespace Scenes;
+
+namespace
+{
+    struct AddGold
+    {
+        static constexpr std::string_view name = "addGold";
+        int operator()(const std::string& amount) const { return std::stoi(amount); }
+    };
+
+    struct OpenDoor
+    {
+        static constexpr std::string_view name = "openDoor";
+        int operator()(const std::string&) const { return 1; }
+    };
+
+    using TestRegistry = EventRegistry<AddGold, OpenDoor>;
+}
+
+static_assert(TestRegistry::size == 2);
+static_assert(TestRegistry::id<AddGold> == 0);
+static_assert(TestRegistry::id<OpenDoor> == 1);
+static_assert(TestRegistry::find("openDoor") == 1);
+static_assert(!TestRegistry::find("closeDoor"));
+
+class EventMapTests : public testing::Test
+{
+protected:
+    size_t linesRead{ 3 };
+    EventLog log{ linesRead };
+};
+
+TEST_F(EventMapTests, EmplaceAssignsDenseIndices)
+{
+    EventMap events;
+    EXPECT_TRUE(events.empty());
+
+    const auto first = [](const std::string&) { return 1; };
+    const auto second = [](const std::string&) { return 2; };
+    EXPECT_EQ(std::make_pair(EventIndex{ 0 }, true), events.emplace("First", first, log));
+    EXPECT_EQ(std::make_pair(EventIndex{ 1 }, true), events.emplace("Second", second, log));
+    EXPECT_EQ(std::make_pair(EventIndex{ 0 }, false), events.emplace("First", second, log));
+
+    ASSERT_EQ(2, events.size());
+    EXPECT_EQ(1, events.find("Second"));
+    EXPECT_FALSE(events.find("Third"));
+    EXPECT_EQ("Second", events[1].name());
+    EXPECT_EQ(&events[0], &events.at("First"));
+    EXPECT_THROW((void)events.at("Third"), std::out_of_range);
+
+    EXPECT_EQ(1, events[0](""));  // The first Event added is kept
+}
+
+TEST_F(EventMapTests, RegistryEventsTakeRegisteredIndices)
+{
+    EventMap events{ TestRegistry(), log };
+    events.emplace("dynamic", [](const std::string&) { return 0; }, log);
+
+    ASSERT_EQ(3, events.size());
+    EXPECT_EQ(TestRegistry::id<AddGold>, events.find("addGold"));
+    EXPECT_EQ(TestRegistry::id<OpenDoor>, events.find("openDoor"));
+    EXPECT_EQ(2, events.find("dynamic"));
+
+    EXPECT_EQ(25, events[TestRegistry::id<AddGold>]("25"));
+    EXPECT_EQ(1, log.count("addGold,25"));
+}
+
+TEST_F(EventMapTests, LinesLinkToRegistryIndices)
+{
+    EventMap events{ TestRegistry(), log };
+
+    Line line{ "Open the door.", "openDoor", "" };
+    ASSERT_TRUE(line.link(events));
+    EXPECT_EQ(TestRegistry::id<OpenDoor>, line.eventId());
+
+    std::stringstream ss;
+    line.readLine(ss, events);
+    EXPECT_EQ(std::vector<size_t>{ linesRead }, log.query("openDoor,1"));
+}
@@ -0,0 +1,67 @@
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "Scenes/EventPool.hpp"
+
+using namespace Scenes;
+
+TEST(EventPoolTests, RunsEveryTask)
+{
+    std::atomic<int> sum{ 0 };
+    {
+        EventPool pool{ 4, 8 };
+        EXPECT_EQ(4, pool.workers());
+        for (int i = 1; i <= 100; i++)
+            pool.submit([&sum, i] { sum += i; });
+    }
+
+    EXPECT_EQ(5050, sum);
+}
+
+TEST(EventPoolTests, SubmitBlocksWhileFull)
+{
+    std::promise<void> started;
+    std::promise<void> release;
+    std::atomic<int> ran{ 0 };
+    std::atomic<bool> submitted{ false };
+    {
+        EventPool pool{ 1, 1 };
+        pool.submit([&started, released = release.get_future(), &ran]() mutable {
+            started.set_value();
+            released.wait();
+            ran++;
+        });
+        started.get_future().wait(); // The only worker is busy and the queue is empty
+        pool.submit([&ran] { ran++; }); // Fills the queue
+
+        std::thread submitter([&] {
+            pool.submit([&ran] { ran++; });
+            submitted = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(submitted);
+
+        release.set_value();
+        submitter.join();
+        EXPECT_TRUE(submitted);
+    }
+
+    EXPECT_EQ(3, ran);
+}
+
+TEST(EventPoolTests, IgnoresTaskExceptions)
+{
+    std::atomic<int> ran{ 0 };
+    {
+        EventPool pool{ 0, 0 };
+        EXPECT_EQ(1, pool.workers());
+        pool.submit([] { throw std::runtime_error("Failed"); });
+        pool.submit([&ran] { ran++; });
+    }
+
+    EXPECT_EQ(1, ran);
+}
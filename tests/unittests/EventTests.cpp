@@ -66,6 +66,21 @@ TEST_F(EventTests, ValueEventCanTakeReference)
 
 }
 
+TEST_F(EventTests, LoggedUnderEventKey)
+{
+    (void)eve(3);
+    EXPECT_EQ((EventKey{ log.intern("test"), 3 }), eve.eventKey());
+    EXPECT_EQ(log.query(eve.eventKey()), log.query(createEventString("test", 3)));
+    EXPECT_EQ(std::vector<size_t>{ linesRead }, log.query(eve.eventKey()));
+}
+
+TEST_F(EventTests, DeferredEventsDontLog)
+{
+	Event<int> deferred{ [](const int a) -> int { return a; }, "deferred", log, EventLogging::Deferred };
+	EXPECT_EQ(4, deferred(4));
+	EXPECT_TRUE(log.query(deferred.eventKey()).empty());
+}
+
 TEST_F(EventTests, IsMoveConstructible)
 {
 	EXPECT_TRUE(std::is_move_constructible<Event<std::string> >::value);
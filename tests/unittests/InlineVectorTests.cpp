@@ -0,0 +1,49 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <gtest/gtest.h>
+
+#include "Scenes/InlineVector.hpp"
+
+using namespace Scenes;
+
+TEST(InlineVectorTests, StoresFirstValuesInline)
+{
+    InlineVector<std::string, 2> values;
+    EXPECT_TRUE(values.empty());
+    EXPECT_TRUE(values.isInline());
+
+    values.push_back("Line 1");
+    values.emplace_back("Line 2");
+    EXPECT_TRUE(values.isInline());
+    EXPECT_EQ(2, values.size());
+
+    values.emplace_back(values[0]); // Copies a value that is moved while growing
+    EXPECT_FALSE(values.isInline());
+    EXPECT_EQ((InlineVector<std::string, 2>{ "Line 1", "Line 2", "Line 1" }), values);
+}
+
+TEST(InlineVectorTests, CopiesAndMoves)
+{
+    InlineVector<std::unique_ptr<int>, 1> inlineValues;
+    inlineValues.push_back(std::make_unique<int>(1));
+
+    auto movedInline = std::move(inlineValues);
+    EXPECT_TRUE(inlineValues.empty());
+    ASSERT_EQ(1, movedInline.size());
+    EXPECT_EQ(1, *movedInline[0]);
+
+    movedInline.push_back(std::make_unique<int>(2));
+    const int* heapValue = movedInline[1].get();
+    auto movedHeap = std::move(movedInline);
+    EXPECT_TRUE(movedInline.isInline());
+    EXPECT_EQ(heapValue, movedHeap[1].get()); // Heap storage is taken over
+
+    const InlineVector<std::string, 1> strings{ "Scene 1", "Scene 2" };
+    InlineVector<std::string, 1> copy;
+    copy = strings;
+    EXPECT_EQ(strings, copy);
+    copy.clear();
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(2, strings.size());
+}
@@ -0,0 +1,161 @@
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Scenes/EventLog.hpp"
+#include "Scenes/Journal.hpp"
+
+using namespace Scenes;
+
+class JournalTests : public testing::Test
+{
+protected:
+	std::filesystem::path path;
+	size_t linesRead;
+	Log sceneLog;
+	EventLog eventLog;
+
+	JournalTests()
+		: path(std::filesystem::temp_directory_path()
+			/ ("JournalTests." + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + "."
+				+ std::to_string(std::random_device{}()) + ".bin")),
+		  linesRead(0), sceneLog(linesRead), eventLog(linesRead)
+	{
+		std::filesystem::remove(path);
+	}
+
+	~JournalTests() override
+	{
+		std::filesystem::remove(path);
+	}
+
+	std::vector<std::string> replay() const
+	{
+		std::vector<std::string> entries;
+		Journal::replay(path, [&](const JournalEntry& entry)
+		{
+			entries.push_back(std::to_string(static_cast<int>(entry.kind)) + ":" + std::to_string(entry.channel) + ":"
+				+ std::to_string(entry.line) + ":" + std::string(entry.name) + ":" + std::to_string(entry.key.returnValue));
+		});
+		return entries;
+	}
+};
+
+TEST_F(JournalTests, ReplaysRecordsInOrder)
+{
+	{
+		Journal journal{ path, { JournalSync::Never } };
+		journal.logName(0, 3, "Example Scene");
+		journal.logEvent(5, { 4, -2 }, "Example Event");
+		journal.logProgress(JournalEntry::Kind::Line, 6);
+		journal.logEvent(2, { 4, 7 }, "Example Event"); // Lines may go backwards after loading a save
+		journal.logProgress(JournalEntry::Kind::SectionEnd, 2);
+	}
+
+	const std::vector<std::string> expected = {
+		"0:0:3:Example Scene:0", "1:0:5:Example Event:-2", "2:0:6::0", "1:0:2:Example Event:7", "3:0:2::0"
+	};
+	EXPECT_EQ(expected, replay());
+}
+
+TEST_F(JournalTests, LogsJournalTheirAppends)
+{
+	{
+		Journal journal{ path };
+		sceneLog.setJournal(&journal, 0);
+		eventLog.setJournal(&journal, 1);
+
+		for (linesRead = 1; linesRead <= 500; linesRead++)
+		{
+			if (linesRead % 50 == 0)
+				sceneLog.addLog("Scene " + std::to_string(linesRead / 100));
+			eventLog.addLog(EventKey{ eventLog.intern("Example Event"), static_cast<int>(linesRead % 3) });
+			if (linesRead % 7 == 0)
+				eventLog.addLog("Not an eventString");
+		}
+		journal.flush();
+	}
+
+	size_t replayedLines = 0;
+	Log replayedScenes(replayedLines);
+	EventLog replayedEvents(replayedLines);
+	ASSERT_EQ(0u, replayedEvents.intern("Other Event")); // Ids differ from the journaling EventLog
+
+	size_t replayed = 0;
+	const auto end = Journal::replay(path, [&](const JournalEntry& entry)
+	{
+		replayed++;
+		replayedLines = entry.line;
+		if (entry.kind == JournalEntry::Kind::Event)
+			replayedEvents.addLog(EventKey{ replayedEvents.intern(std::string(entry.name)), entry.key.returnValue });
+		else if (entry.channel == 0)
+			replayedScenes.addLog(std::string(entry.name));
+		else
+			replayedEvents.addLog(std::string(entry.name));
+	});
+
+	EXPECT_EQ(500u + 10u + 71u, replayed);
+	EXPECT_EQ(std::filesystem::file_size(path), end);
+	for (const auto name : { "Scene 0", "Scene 1", "Scene 5" })
+		EXPECT_EQ(sceneLog.query(name), replayedScenes.query(name));
+	for (const auto name : { "Example Event,0", "Example Event,1", "Example Event,2", "Not an eventString" })
+		EXPECT_EQ(eventLog.query(name), replayedEvents.query(name));
+}
+
+TEST_F(JournalTests, StopsAtTornCommit)
+{
+	{
+		Journal journal{ path };
+		journal.logName(0, 1, "Example Scene");
+		journal.flush();
+		journal.logName(0, 2, "Example Scene 2");
+	}
+	ASSERT_EQ(2u, replay().size());
+
+	// Cut the last commit short, as a crash during its write would.
+	std::filesystem::resize_file(path, std::filesystem::file_size(path) - 3);
+	EXPECT_EQ(std::vector<std::string>{ "0:0:1:Example Scene:0" }, replay());
+}
+
+TEST_F(JournalTests, AppendsAfterTornCommit)
+{
+	{
+		Journal journal{ path };
+		journal.logName(0, 1, "Example Scene");
+		journal.flush();
+		journal.logName(0, 2, "Example Scene 2");
+	}
+	const auto torn = std::filesystem::file_size(path) - 3;
+	std::filesystem::resize_file(path, torn);
+
+	// Reopening cuts off the torn commit, so commits made after recovering are replayed.
+	{
+		Journal journal{ path };
+		EXPECT_LT(std::filesystem::file_size(path), torn);
+		journal.logName(0, 3, "Example Scene 3");
+	}
+	const std::vector<std::string> expected = { "0:0:1:Example Scene:0", "0:0:3:Example Scene 3:0" };
+	EXPECT_EQ(expected, replay());
+}
+
+TEST_F(JournalTests, ClearEmptiesJournal)
+{
+	Journal journal{ path, { JournalSync::Periodic, std::chrono::milliseconds(0), std::chrono::milliseconds(1) } };
+	journal.logEvent(1, { 0, 1 }, "Example Event");
+	journal.clear();
+	EXPECT_TRUE(replay().empty());
+
+	// Event names are written again after a clear.
+	journal.logEvent(2, { 0, 1 }, "Example Event");
+	journal.flush();
+	EXPECT_EQ(std::vector<std::string>{ "1:0:2:Example Event:1" }, replay());
+}
+
+TEST_F(JournalTests, ReplayOfMissingJournalIsEmpty)
+{
+	EXPECT_EQ(0u, Journal::replay(path, [](const JournalEntry&) { FAIL(); }));
+	EXPECT_THROW(Journal(std::filesystem::temp_directory_path() / "Missing Directory" / "Journal.bin"), JournalError);
+}
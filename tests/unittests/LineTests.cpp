@@ -1,4 +1,5 @@
 #include <sstream>
+#include <utility>
 #include <gtest/gtest.h>
 
 #include "Scenes/Line.hpp"
@@ -13,10 +14,12 @@ protected:
     EventLog log{ linesRead };
     std::string testString = "Test Line";
 
-    EventMap events{
-        {"Test Event", Event<std::string>([](const std::string& s) -> int { return stoi(s); },
-                                          "Test Event", log)}
-    };
+    EventMap events;
+
+    LineTests()
+    {
+        events.emplace("Test Event", [](const std::string& s) -> int { return stoi(s); }, log);
+    }
 };
 
 TEST_F(LineTests, ReadNoEventLine)
@@ -35,11 +38,122 @@ TEST_F(LineTests, ReadEventLine)
     line.readLine(ss, events);
     EXPECT_EQ(testString, ss.str());
 
-    const std::string eventString = line.event(events).value().eventString();
+    ASSERT_EQ(&events.at("Test Event"), line.event(events));
+    const std::string eventString = line.event(events)->eventString();
     EXPECT_EQ("Test Event,10", eventString);
     EXPECT_NE(std::vector<size_t>(), log.query(eventString)); // Event logged
 }
 
+TEST_F(LineTests, MissingEvent)
+{
+    Line line{ testString, "Missing Event", "10" };
+    EXPECT_EQ(nullptr, line.event(events));
+    EXPECT_EQ(nullptr, Line(testString).event(std::as_const(events)));
+
+    std::stringstream ss;
+    line.readLine(ss, events);
+    EXPECT_EQ(testString, ss.str());
+    EXPECT_TRUE(log.empty());
+}
+
+TEST_F(LineTests, LinkedLineRunsEventByIndex)
+{
+    Line line{ testString, "Test Event", "10" };
+    EXPECT_FALSE(line.linked());
+    EXPECT_EQ(EventMap::noEvent, line.eventId());
+    EXPECT_TRUE(line.link(events));
+    EXPECT_TRUE(line.linked());
+    EXPECT_EQ(events.find("Test Event"), line.eventId());
+
+    std::stringstream ss;
+    line.readLine(ss, events);
+    EXPECT_EQ(testString, ss.str());
+    EXPECT_EQ(std::vector<size_t>{ linesRead }, log.query("Test Event,10"));
+
+    // Reading with an Event Map lacking the linked index runs nothing rather than reading out of bounds.
+    EventMap empty;
+    line.readLine(ss, empty);
+    EXPECT_EQ(1, log.count("Test Event,10"));
+}
+
+TEST_F(LineTests, LinkUnresolvedEvent)
+{
+    Line line{ testString, "Missing Event", "10" };
+    EXPECT_FALSE(line.link(events));
+    EXPECT_TRUE(Line(testString).link(events)); // Lines without Events always link
+
+    events.emplace("Missing Event", [](const std::string&) -> int { return 0; }, log);
+    std::stringstream ss;
+    line.readLine(ss, events);
+    EXPECT_EQ(testString, ss.str());
+    EXPECT_TRUE(log.empty()); // Stays unresolved until linked again
+}
+
+TEST_F(LineTests, LinkParsesArgumentOnce)
+{
+    int parses = 0;
+    events.emplace("Typed Event", [](const EventArgument& arg) { return arg.get<int>() * 2; }, log,
+                   [&parses](const std::string& text) {
+                       parses++;
+                       return EventArgument(parseArgument<int>(text));
+                   });
+
+    Line line{ testString, "Typed Event", "21" };
+    ASSERT_TRUE(line.link(events));
+    EXPECT_EQ(21, line.argument().get<int>());
+
+    std::stringstream ss;
+    line.readLine(ss, events);
+    line.readLine(ss, events);
+    EXPECT_EQ(1, parses);
+    EXPECT_EQ(2, log.count("Typed Event,42"));
+}
+
+TEST_F(LineTests, LinkRejectsMalformedArgument)
+{
+    events.emplace("Typed Event", [](const EventArgument& arg) { return arg.get<int>(); }, log,
+                   [](const std::string& text) { return EventArgument(parseArgument<int>(text)); });
+
+    Line line{ testString, "Typed Event", "ten" };
+    EXPECT_THROW(line.link(events), EventArgumentError);
+    EXPECT_FALSE(line.linked());
+}
+
+TEST_F(LineTests, RunsEveryEventInOneBatch)
+{
+    size_t loggedDuringBatch = 1;
+    events.emplace("Count Logs", [&](const std::string&) -> int {
+        loggedDuringBatch = log.count(createEventString("Test Event", 3));
+        return 0;
+    }, log);
+
+    Line line{ testString, EventCalls{ { "Test Event", "3" }, { "Missing Event" }, { "Count Logs" } } };
+    EXPECT_EQ(3, line.events().size());
+    EXPECT_EQ("Test Event", line.eventName());
+    EXPECT_EQ("3", line.eventArg());
+
+    EXPECT_FALSE(line.link(events));
+    EXPECT_EQ(EventMap::noEvent, line.events()[1].index);
+
+    std::stringstream ss;
+    line.readLine(ss, events);
+    EXPECT_EQ(testString, ss.str());
+    EXPECT_EQ(0, loggedDuringBatch); // Results are logged once every Event has run
+    EXPECT_EQ(std::vector<size_t>{ linesRead }, log.query(createEventString("Test Event", 3)));
+    EXPECT_EQ(std::vector<size_t>{ linesRead }, log.query(createEventString("Count Logs", 0)));
+}
+
+TEST_F(LineTests, LinkRejectsAnyMalformedArgument)
+{
+    events.emplace("Typed Event", [](const EventArgument& arg) { return arg.get<int>(); }, log,
+                   [](const std::string& text) { return EventArgument(parseArgument<int>(text)); });
+
+    Line line{ testString, EventCalls{ { "Typed Event", "4" }, { "Typed Event", "four" } } };
+    EXPECT_THROW(line.link(events), EventArgumentError);
+    EXPECT_FALSE(line.linked());
+    EXPECT_EQ(EventMap::noEvent, line.events()[0].index);
+}
+
 TEST_F(LineTests, IsMoveConstructible)
 {
     EXPECT_TRUE(std::is_move_constructible<Line>::value);
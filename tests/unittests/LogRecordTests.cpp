@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Scenes/LogRecord.hpp"
+#include "Scenes/Snapshot.hpp"
+
+using namespace Scenes;
+
+class LogRecordTests : public testing::Test
+{
+protected:
+	LogRecord record;
+	std::vector<size_t> lines;
+
+	LogRecordTests()
+	{
+		// Mix small and large gaps so deltas take one or several bytes, across many blocks.
+		size_t line = 3;
+		for (size_t i = 0; i < 10 * LogRecord::blockSize; i++)
+		{
+			line += (i % 7 == 0) ? 100000 : i % 3;
+			lines.push_back(line);
+			record.append(line);
+		}
+	}
+};
+
+TEST_F(LogRecordTests, RetainedDecodesEveryLine)
+{
+	EXPECT_TRUE(std::ranges::equal(lines, record.retained()));
+
+	record.append(lines.back() + 1);
+	lines.push_back(lines.back() + 1);
+	EXPECT_TRUE(std::ranges::equal(lines, record.retained()));
+	EXPECT_EQ(lines.back(), record.retained().back());
+}
+
+TEST_F(LogRecordTests, RangeQueriesMatchLinearSearch)
+{
+	for (size_t from = lines.front() - 1; from <= lines.back() + 1; from += 997)
+	{
+		const auto to = from + 5000;
+		const auto expectedCount = std::ranges::count_if(lines, [&](size_t l) { return l >= from && l <= to; });
+		const auto expectedNext = std::ranges::lower_bound(lines, from);
+
+		EXPECT_EQ(static_cast<size_t>(expectedCount), record.countBetween(from, to));
+		if (expectedNext == lines.end())
+			EXPECT_EQ(std::nullopt, record.firstAtOrAfter(from));
+		else
+			EXPECT_EQ(*expectedNext, record.firstAtOrAfter(from));
+	}
+}
+
+TEST_F(LogRecordTests, NthFromBackMatchesRetained)
+{
+	for (size_t n = 0; n < lines.size(); n += 13)
+		EXPECT_EQ(lines[lines.size() - 1 - n], record.nthFromBack(n));
+	EXPECT_EQ(std::nullopt, record.nthFromBack(lines.size()));
+
+	record.setPolicy(RetentionPolicy::keepLast(LogRecord::blockSize + 1));
+	(void)record.compact();
+	EXPECT_EQ(*(lines.end() - LogRecord::blockSize - 1), record.nthFromBack(LogRecord::blockSize));
+	EXPECT_THROW((void)record.nthFromBack(LogRecord::blockSize + 1), DiscardedLogError);
+}
+
+TEST_F(LogRecordTests, SmallerThanPlainVector)
+{
+	EXPECT_LT(record.memoryUsage(), lines.size() * sizeof(size_t));
+}
+
+TEST_F(LogRecordTests, CompactionKeepsLatestLines)
+{
+	record.setPolicy(RetentionPolicy::keepLast(LogRecord::blockSize + 1));
+	EXPECT_TRUE(record.needsCompaction());
+	EXPECT_EQ(lines.size() - LogRecord::blockSize - 1, record.compact());
+
+	const std::vector<size_t> kept(lines.end() - LogRecord::blockSize - 1, lines.end());
+	const size_t lastDiscarded = *(lines.end() - LogRecord::blockSize - 2);
+	EXPECT_TRUE(std::ranges::equal(kept, record.retained()));
+	EXPECT_EQ(lines.size(), record.count());
+	EXPECT_EQ(lines.front(), record.first());
+
+	const auto from = lastDiscarded + 1;
+	const auto expectedCount = std::ranges::count_if(kept, [&](size_t l) { return l >= from && l <= kept[5]; });
+	EXPECT_EQ(static_cast<size_t>(expectedCount), record.countBetween(from, kept[5]));
+	EXPECT_EQ(*std::ranges::lower_bound(kept, from), record.firstAtOrAfter(from));
+	EXPECT_THROW((void)record.countBetween(lastDiscarded, kept[5]), DiscardedLogError);
+	EXPECT_THROW((void)record.firstAtOrAfter(lastDiscarded), DiscardedLogError);
+}
+
+TEST_F(LogRecordTests, ReadRejectsCorruptRecords)
+{
+	SnapshotWriter writer;
+	record.write(writer);
+	const auto data = writer.data();
+
+	SnapshotReader reader{ data };
+	EXPECT_TRUE(std::ranges::equal(lines, LogRecord::read(reader).retained()));
+
+	// Fields follow the policy's mode byte and limit; the encoded bytes and skip entries follow the fields.
+	const size_t fields = sizeof(std::uint8_t) + sizeof(std::uint64_t);
+	const size_t tail = fields + sizeof(std::uint64_t);
+	const size_t bytesSize = fields + 6 * sizeof(std::uint64_t);
+	std::uint64_t encodedSize;
+	std::memcpy(&encodedSize, data.data() + bytesSize, sizeof(encodedSize));
+	const size_t secondSkipLine = bytesSize + 2 * sizeof(std::uint64_t) + encodedSize + 3 * sizeof(std::uint64_t);
+
+	for (const size_t corrupted : { tail, secondSkipLine })
+	{
+		auto bad = data;
+		bad[corrupted] ^= 1;
+		SnapshotReader badReader{ bad };
+		EXPECT_THROW((void)LogRecord::read(badReader), SnapshotError);
+	}
+
+	// Records of one line whose encoding is unterminated, longer than 64 bits, or decreases past the last line.
+	const std::vector<std::vector<std::uint8_t> > encodings{
+		{ 0x85 },
+		{ 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 },
+		{ 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x01 }
+	};
+	for (const auto& encoding : encodings)
+	{
+		SnapshotWriter badWriter;
+		RetentionPolicy::keepAll().write(badWriter);
+		const size_t size = encoding.front() == 0x05 ? 2 : 1;
+		for (const size_t value : { size, size_t{ 5 }, size_t{ 5 }, size_t{ 5 }, size, size_t{ 0 } })
+			badWriter.write<std::uint64_t>(value);
+		badWriter.writeArray(std::span<const std::uint8_t>(encoding));
+		badWriter.write<std::uint64_t>(1);
+		badWriter.write<std::uint64_t>(1);
+		badWriter.write<std::uint64_t>(5);
+
+		SnapshotReader badReader{ badWriter.data() };
+		EXPECT_THROW((void)LogRecord::read(badReader), SnapshotError);
+	}
+}
@@ -1,4 +1,8 @@
 #include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 #include <gtest/gtest.h>
 
 #include "Scenes/Log.hpp"
@@ -63,7 +67,197 @@ TEST_F(LogTests, FindLogCorrectly)
 	EXPECT_EQ(std::vector<Scenes::LogNameType>{}, log.findKeys("NonExistent"));
 }
 
+TEST_F(LogTests, ViewAndAccessors)
+{
+	EXPECT_TRUE(log.view("Test Log").empty());
+	EXPECT_EQ(std::nullopt, log.first("Test Log"));
+	EXPECT_EQ(std::nullopt, log.last("Test Log"));
+	EXPECT_EQ(0, log.count("Test Log"));
+
+	log.addLog("Test Log");
+	linesRead += 3;
+	log.addLog("Test Log");
+	linesRead += 4;
+	log.addLog("Test Log");
+
+	const LogResultType expected{ 0, 3, 7 };
+	const auto view = log.view("Test Log");
+	EXPECT_TRUE(std::ranges::equal(expected, view));
+	EXPECT_EQ(0, log.first("Test Log"));
+	EXPECT_EQ(7, log.last("Test Log"));
+	EXPECT_EQ(3, log.count("Test Log"));
+}
+
+TEST_F(LogTests, LineRangeQueries)
+{
+	for (const size_t line : { 2, 5, 5, 9, 14 })
+	{
+		linesRead = line;
+		log.addLog("Test Log");
+	}
+
+	EXPECT_EQ(5, log.countBetween("Test Log", 0, 100));
+	EXPECT_EQ(3, log.countBetween("Test Log", 5, 9));
+	EXPECT_EQ(0, log.countBetween("Test Log", 6, 8));
+	EXPECT_EQ(0, log.countBetween("Test Log", 9, 5));
+	EXPECT_EQ(0, log.countBetween("Other Log", 0, 100));
+
+	EXPECT_EQ(2, log.firstAtOrAfter("Test Log", 0));
+	EXPECT_EQ(5, log.firstAtOrAfter("Test Log", 3));
+	EXPECT_EQ(14, log.firstAtOrAfter("Test Log", 14));
+	EXPECT_EQ(std::nullopt, log.firstAtOrAfter("Test Log", 15));
+	EXPECT_EQ(std::nullopt, log.firstAtOrAfter("Other Log", 0));
+}
+
+TEST_F(LogTests, KeepLastRetention)
+{
+	log.setRetention(RetentionPolicy::keepLast(2));
+
+	for (size_t line = 0; line < 100; line++)
+	{
+		linesRead = line;
+		log.addLog("Test Log");
+	}
+
+	EXPECT_LE(log.view("Test Log").size(), 4);
+	EXPECT_EQ(99, log.view("Test Log").back());
+	EXPECT_EQ(0, log.first("Test Log"));
+	EXPECT_EQ(99, log.last("Test Log"));
+	EXPECT_EQ(100, log.count("Test Log"));
+
+	EXPECT_EQ(2, log.countBetween("Test Log", 98, 200)); // Answered from kept line numbers
+	EXPECT_EQ(100, log.countBetween("Test Log", 0, 99)); // Covers the whole record
+	EXPECT_EQ(99, log.firstAtOrAfter("Test Log", 99));
+	EXPECT_THROW((void)log.countBetween("Test Log", 10, 20), DiscardedLogError);
+	EXPECT_THROW((void)log.firstAtOrAfter("Test Log", 10), DiscardedLogError);
+}
+
+TEST_F(LogTests, SummaryRetention)
+{
+	log.setRetention("Summary Log", RetentionPolicy::summary());
+
+	for (const size_t line : { 3, 5, 8 })
+	{
+		linesRead = line;
+		log.addLog("Summary Log");
+		log.addLog("Test Log");
+	}
+
+	EXPECT_TRUE(log.view("Summary Log").empty());
+	EXPECT_EQ(3, log.first("Summary Log"));
+	EXPECT_EQ(8, log.last("Summary Log"));
+	EXPECT_EQ(3, log.count("Summary Log"));
+	EXPECT_EQ(3, log.countBetween("Summary Log", 0, 8));
+	EXPECT_EQ(0, log.countBetween("Summary Log", 9, 20));
+	EXPECT_THROW((void)log.countBetween("Summary Log", 4, 8), DiscardedLogError);
+
+	EXPECT_EQ(3, log.view("Test Log").size()); // Other records keep the default policy
+}
+
+TEST_F(LogTests, CompactionRunsIncrementally)
+{
+	for (size_t line = 0; line < 1000; line++)
+	{
+		linesRead = line;
+		log.addLog("Test Log 1");
+		log.addLog("Test Log 2");
+	}
+
+	log.setRetention(RetentionPolicy::keepLast(10));
+	EXPECT_EQ(1000, log.view("Test Log 1").size()); // Nothing is trimmed until the Log is written to
+
+	log.addLog("Other Log");
+	const auto remaining = log.view("Test Log 1").size() + log.view("Test Log 2").size();
+	EXPECT_LT(remaining, 2000);
+	EXPECT_GT(remaining, 20);
+
+	EXPECT_EQ(remaining - 20, log.compact());
+	EXPECT_EQ(10, log.view("Test Log 1").size());
+	EXPECT_EQ(10, log.view("Test Log 2").size());
+	EXPECT_EQ(1000, log.count("Test Log 1"));
+}
+
 TEST_F(LogTests, IsMoveConstructible)
 {
 	EXPECT_TRUE(std::is_move_constructible<Log>::value);
-}
\ No newline at end of file
+}
+TEST_F(LogTests, ConcurrentAppends)
+{
+	constexpr int threads = 4;
+	constexpr int appends = 1000;
+
+	log.setConcurrent(true);
+	EXPECT_TRUE(log.concurrent());
+	linesRead = 7;
+
+	std::vector<std::thread> appenders;
+	for (int thread = 0; thread < threads; thread++)
+		appenders.emplace_back([this, thread] {
+			for (int i = 0; i < appends; i++)
+				log.addLog("Test Log " + std::to_string(thread % 2));
+		});
+	for (auto& appender : appenders)
+		appender.join();
+
+	// Nothing is visible until the owning thread synchronizes, and then everything is, at the same line.
+	EXPECT_EQ(0u, log.count("Test Log 0"));
+	EXPECT_EQ(0u, log.epoch());
+
+	EXPECT_EQ(static_cast<size_t>(threads * appends), log.synchronize());
+	EXPECT_EQ(1u, log.epoch());
+	EXPECT_EQ(static_cast<size_t>(threads * appends / 2), log.count("Test Log 0"));
+	EXPECT_EQ(7u, log.first("Test Log 1"));
+	EXPECT_EQ(7u, log.last("Test Log 1"));
+
+	EXPECT_EQ(0u, log.synchronize());
+	EXPECT_EQ(1u, log.epoch()); // Empty synchronizations keep the epoch
+
+	// Turning concurrency off applies what is still queued.
+	linesRead = 8;
+	log.addLog("Test Log 0");
+	log.setConcurrent(false);
+	EXPECT_EQ(8u, log.last("Test Log 0"));
+	log.addLog("Test Log 0");
+	EXPECT_EQ(static_cast<size_t>(threads * appends / 2 + 2), log.count("Test Log 0"));
+}
+
+TEST_F(LogTests, RaisesDependentsOfLoggedRecords)
+{
+	const auto door = std::make_shared<bool>(false);
+	auto cellar = std::make_shared<bool>(false);
+	log.addDependent("Door", door);
+	log.addDependent("Cellar", cellar);
+
+	log.addLog("Window");
+	EXPECT_FALSE(*door);
+	EXPECT_FALSE(*cellar);
+
+	log.addLog("Door");
+	EXPECT_TRUE(*door);
+	EXPECT_FALSE(*cellar);
+
+	cellar.reset(); // Destroyed flags are dropped rather than raised
+	log.addLog("Cellar");
+
+	DependentFlags flags;
+	for (int i = 0; i < 100; i++)
+		flags.add(std::make_shared<bool>(false));
+	EXPECT_LT(flags.size(), 100u); // Destroyed flags are dropped as flags are added
+	flags.add(door);
+	flags.raise();
+	EXPECT_EQ(1u, flags.size());
+}
+
+TEST_F(LogTests, MemoryUsageGrowsWithRecords)
+{
+	const auto empty = log.memoryUsage();
+	EXPECT_GE(empty, sizeof(Log));
+
+	log.addLog("A record with a name too long to be stored inline");
+	const auto oneRecord = log.memoryUsage();
+	EXPECT_GT(oneRecord, empty + sizeof(LogRecord));
+
+	for (int i = 0; i < 100; i++)
+		log.addLog("A record with a name too long to be stored inline");
+	EXPECT_LT(log.memoryUsage(), oneRecord + 100 * sizeof(size_t)); // Appends are delta-encoded
+}
@@ -0,0 +1,123 @@
+#include <chrono>
+#include <future>
+#include <thread>
+#include <gtest/gtest.h>
+
+#include "Scenes/Pacing.hpp"
+
+using namespace Scenes;
+using namespace std::chrono_literals;
+
+namespace
+{
+    using Clock = DeadlinePacing::Clock;
+
+    Clock::duration timeWaited(Pacing& pacing)
+    {
+        const auto start = Clock::now();
+        pacing.awaitNextLine();
+        return Clock::now() - start;
+    }
+}
+
+TEST(PacingTests, HeadlessNeverWaits)
+{
+    HeadlessPacing pacing;
+    for (int i = 0; i < 1000; i++)
+    {
+        pacing.awaitNextLine();
+        pacing.lineRead(Line("Line"));
+    }
+    EXPECT_LT(timeWaited(pacing), 50ms);
+}
+
+TEST(PacingTests, FixedWaitsFromTheLastLine)
+{
+    FixedPacing pacing{ 40ms };
+    EXPECT_LT(timeWaited(pacing), 20ms); // The first Line is read at once
+
+    pacing.lineRead(Line("Line"));
+    EXPECT_GE(timeWaited(pacing), 40ms);
+
+    // Time spent after a Line counts towards the wait.
+    pacing.lineRead(Line("Line"));
+    std::this_thread::sleep_for(40ms);
+    EXPECT_LT(timeWaited(pacing), 20ms);
+}
+
+TEST(PacingTests, TypewriterWaitsPerCharacter)
+{
+    TypewriterPacing pacing{ 5ms, 20ms };
+
+    pacing.lineRead(Line("Twelve chars"));
+    EXPECT_GE(timeWaited(pacing), 60ms);
+
+    pacing.lineRead(Line(""));
+    EXPECT_GE(timeWaited(pacing), 20ms);
+}
+
+TEST(PacingTests, SkipEndsTheWait)
+{
+    FixedPacing pacing{ 10s };
+    pacing.lineRead(Line("Line"));
+
+    auto waited = std::async(std::launch::async, [&pacing] { return timeWaited(pacing); });
+    std::this_thread::sleep_for(20ms);
+    pacing.skip();
+    EXPECT_LT(waited.get(), 5s);
+}
+
+TEST(PacingTests, DeadlineIsPolledWithoutWaiting)
+{
+    FixedPacing pacing{ 10s };
+    const auto now = Clock::now();
+    EXPECT_TRUE(pacing.ready(now)); // The first Line is read at once
+
+    pacing.lineRead(Line("Line"));
+    EXPECT_FALSE(pacing.ready(now));
+    ASSERT_TRUE(pacing.nextDeadline());
+    EXPECT_GE(*pacing.nextDeadline(), now + 10s);
+    EXPECT_TRUE(pacing.ready(*pacing.nextDeadline()));
+
+    pacing.skip();
+    EXPECT_TRUE(pacing.ready(now));
+}
+
+TEST(PacingTests, TicksArePolledWithoutWaiting)
+{
+    TickedPacing pacing;
+    EXPECT_FALSE(pacing.ready(Clock::now()));
+    EXPECT_FALSE(pacing.nextDeadline());
+
+    pacing.tick();
+    EXPECT_TRUE(pacing.ready(Clock::now()));
+    EXPECT_TRUE(pacing.nextDeadline());
+
+    pacing.lineRead(Line("Line"));
+    EXPECT_FALSE(pacing.ready(Clock::now()));
+}
+
+TEST(PacingTests, TickedWaitsForTicks)
+{
+    TickedPacing pacing;
+    pacing.tick(2);
+    for (int i = 0; i < 2; i++)
+    {
+        pacing.awaitNextLine();
+        pacing.lineRead(Line("Line"));
+    }
+    EXPECT_EQ(0u, pacing.pendingTicks());
+
+    std::promise<void> waiting;
+    auto read = std::async(std::launch::async, [&] {
+        waiting.set_value();
+        pacing.awaitNextLine();
+    });
+    waiting.get_future().wait();
+    EXPECT_EQ(std::future_status::timeout, read.wait_for(20ms));
+
+    pacing.tick();
+    read.get();
+    pacing.lineRead(Line("Line"));
+    EXPECT_EQ(0u, pacing.pendingTicks());
+}
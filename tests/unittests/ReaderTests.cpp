@@ -0,0 +1,282 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Scenes/Reader.hpp"
+
+using namespace Scenes;
+using namespace std::chrono_literals;
+
+class ReaderTests : public testing::Test
+{
+protected:
+    std::filesystem::path sceneLoc;
+
+    ReaderTests()
+        : sceneLoc(std::filesystem::temp_directory_path()
+                   / ("ReaderTests." + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()) + "."
+                      + std::to_string(std::random_device{}())))
+    {
+        std::filesystem::remove_all(sceneLoc);
+        std::filesystem::create_directories(sceneLoc);
+
+        // The pause signal stops the first Section after "b", so "c" is never read.
+        std::ofstream{ sceneLoc / "Opening.json" } << R"([
+            { "lines": [ { "text": "a" }, { "text": "b", "event": "pause" }, { "text": "c" } ] },
+            { "lines": [ { "text": "d" } ] }
+        ])";
+    }
+
+    ~ReaderTests() override
+    {
+        std::filesystem::remove_all(sceneLoc);
+    }
+
+    std::string readOpening(Reader& reader) const
+    {
+        reader.setPacing(nullptr);
+        reader.addEvent("pause", [] { return 1; });
+
+        std::ostringstream ss;
+        reader.readFrom("Opening", ss);
+        return ss.str();
+    }
+};
+
+TEST_F(ReaderTests, IsNeitherCopiedNorMoved)
+{
+    EXPECT_FALSE(std::is_copy_constructible<Reader>::value);
+    EXPECT_FALSE(std::is_move_constructible<Reader>::value);
+    EXPECT_FALSE(std::is_copy_assignable<Reader>::value);
+    EXPECT_FALSE(std::is_move_assignable<Reader>::value);
+}
+
+TEST_F(ReaderTests, ActsOnlyOnItsOwnSignals)
+{
+    Reader first{ sceneLoc.string(), sceneLoc.string() };
+    EXPECT_EQ("abd", readOpening(first));
+
+    // A signal acted on by another Reader at the same line is still acted on.
+    Reader second{ sceneLoc.string(), sceneLoc.string() };
+    EXPECT_EQ("abd", readOpening(second));
+}
+
+TEST_F(ReaderTests, ReadsConcurrently)
+{
+    constexpr int readers = 8;
+    std::vector<std::string> results(readers);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < readers; i++)
+        threads.emplace_back([this, &results, i]
+        {
+            for (int read = 0; read < 20; read++)
+            {
+                Reader reader{ sceneLoc.string(), sceneLoc.string() };
+                results[i] += readOpening(reader);
+            }
+        });
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& result : results)
+    {
+        std::string expected;
+        for (int read = 0; read < 20; read++)
+            expected += "abd";
+        EXPECT_EQ(expected, result);
+    }
+}
+
+TEST_F(ReaderTests, StepsWithoutWaitingOnItsPacing)
+{
+    std::filesystem::create_directories(sceneLoc / "Scenes");
+    std::ofstream{ sceneLoc / "Scenes" / "Save.json" } << R"({ "current scene": "Opening" })";
+    Reader reader{ sceneLoc.string(), sceneLoc.string(), "Save" };
+    const auto pacing = std::make_shared<TickedPacing>();
+    reader.setPacing(pacing);
+    reader.addEvent("pause", [] { return 1; });
+    reader.start();
+
+    std::ostringstream ss;
+    for (int i = 0; i < 10; i++)
+        EXPECT_TRUE(reader.step(ss));
+    EXPECT_EQ("", ss.str());
+
+    pacing->tick(2);
+    EXPECT_TRUE(reader.step(ss));
+    EXPECT_TRUE(reader.step(ss));
+    EXPECT_TRUE(reader.step(ss));
+    EXPECT_EQ("ab", ss.str());
+
+    pacing->tick();
+    while (reader.step(ss));
+    EXPECT_EQ("abd", ss.str());
+    EXPECT_EQ(0u, pacing->pendingTicks());
+}
+
+TEST_F(ReaderTests, RejectsEventsAddedTwice)
+{
+    Reader reader{ sceneLoc.string(), sceneLoc.string() };
+    EXPECT_TRUE(reader.hasEvent("setNextScene"));
+    EXPECT_THROW(reader.addEvent("setNextScene", [] { return 1; }), std::invalid_argument);
+
+    reader.setPacing(nullptr);
+    reader.addEvent("pause", [] { return 1; });
+    EXPECT_THROW(reader.addEvent("pause", [] { return 2; }), std::invalid_argument);
+
+    std::ostringstream ss;
+    reader.readFrom("Opening", ss);
+    EXPECT_EQ("abd", ss.str()); // The Event added first is kept
+}
+
+TEST_F(ReaderTests, SavesAgainAfterReadingFromAScene)
+{
+    std::filesystem::create_directories(sceneLoc / "Scenes");
+    std::ofstream{ sceneLoc / "Scenes" / "Save.json" } << R"({ "current scene": "Stop" })";
+    std::ofstream{ sceneLoc / "Stop.json" } << R"([
+        { "lines": [ { "text": "s", "event": "stop" }, { "text": "t" } ] }
+    ])";
+
+    Reader reader{ sceneLoc.string(), sceneLoc.string(), "Save" };
+    reader.setPacing(nullptr);
+    reader.addEvent("stop", [] { return 1; });
+
+    std::ostringstream ss;
+    reader.readFrom("Stop", ss);
+    EXPECT_FALSE(std::filesystem::exists(sceneLoc / "Scenes" / "Snapshot.bin"));
+
+    reader.read(ss);
+    EXPECT_TRUE(std::filesystem::exists(sceneLoc / "Scenes" / "Snapshot.bin"));
+}
+
+TEST_F(ReaderTests, ReplaysEventIdsRedefinedByLaterRuns)
+{
+    // Each run appending to the journal numbers its Events from 0.
+    std::filesystem::create_directories(sceneLoc / "Scenes");
+    const auto journalPath = sceneLoc / "Scenes" / "Journal.bin";
+    {
+        Journal journal{ journalPath };
+        journal.logName(0, 1, "Opening");
+        journal.logEvent(1, { 0, 1 }, "Door");
+    }
+    {
+        Journal journal{ journalPath };
+        journal.logEvent(2, { 0, 1 }, "Window");
+    }
+
+    Reader reader{ sceneLoc.string(), sceneLoc.string(), "Save" };
+    reader.enableJournal();
+    reader.start();
+    EXPECT_EQ(1u, reader.eventLog().count("Door,1"));
+    EXPECT_EQ(1u, reader.eventLog().count("Window,1"));
+}
+
+TEST_F(ReaderTests, ResumesTheNextSceneSetBeforeACrash)
+{
+    std::filesystem::create_directories(sceneLoc / "Scenes");
+    std::ofstream{ sceneLoc / "Scenes" / "Save.json" } << R"({ "current scene": "Hub" })";
+    std::ofstream{ sceneLoc / "Hub.json" } << R"([
+        { "lines": [ { "text": "h", "event": "setNextScene", "arg": "Hall" }, { "text": "x" }, { "text": "y" } ] }
+    ])";
+    std::ofstream{ sceneLoc / "Hall.json" } << R"([ { "lines": [ { "text": "i" } ] } ])";
+
+    // The first run stops without saving after setNextScene runs, but before the Scene ends.
+    std::ostringstream ss;
+    {
+        Reader reader{ sceneLoc.string(), sceneLoc.string(), "Save" };
+        reader.setPacing(nullptr);
+        reader.enableJournal();
+        reader.start();
+        while (ss.str() != "hx")
+            ASSERT_TRUE(reader.step(ss));
+    }
+    EXPECT_FALSE(std::filesystem::exists(sceneLoc / "Scenes" / "Snapshot.bin"));
+
+    Reader reader{ sceneLoc.string(), sceneLoc.string(), "Save" };
+    reader.setPacing(nullptr);
+    reader.enableJournal();
+    reader.start();
+    while (reader.step(ss));
+    EXPECT_EQ("hxyi", ss.str());
+}
+
+TEST_F(ReaderTests, MemoryUsageGrowsWithWhatIsRead)
+{
+    Reader reader{ sceneLoc.string(), sceneLoc.string() };
+    const auto unread = reader.memoryUsage();
+    EXPECT_GE(unread, sizeof(Reader));
+
+    readOpening(reader);
+    EXPECT_GT(reader.memoryUsage(), unread);
+}
+
+TEST_F(ReaderTests, ReusesParsedScenesUntilTheirFileChanges)
+{
+    Reader reader{ sceneLoc.string(), sceneLoc.string() };
+    EXPECT_EQ("abd", readOpening(reader));
+    EXPECT_EQ(0u, reader.sceneCache().hits());
+    EXPECT_EQ(1u, reader.sceneCache().size());
+
+    std::ostringstream ss;
+    reader.readFrom("Opening", ss);
+    EXPECT_EQ(1u, reader.sceneCache().hits());
+
+    std::ofstream{ sceneLoc / "Opening.json" } << R"([ { "lines": [ { "text": "e" } ] } ])";
+    std::filesystem::last_write_time(sceneLoc / "Opening.json",
+                                     std::filesystem::last_write_time(sceneLoc / "Opening.json") + 1s);
+    reader.readFrom("Opening", ss);
+    EXPECT_EQ(1u, reader.sceneCache().hits());
+    EXPECT_EQ(2u, reader.sceneCache().misses());
+    EXPECT_EQ("abde", ss.str().substr(ss.str().size() - 4));
+}
+
+TEST_F(ReaderTests, LinksKeptScenesToEventsAddedLater)
+{
+    Reader reader{ sceneLoc.string(), sceneLoc.string() };
+    reader.setPacing(nullptr);
+
+    std::ostringstream ss;
+    reader.readFrom("Opening", ss);
+    EXPECT_EQ("abcd", ss.str()); // No pause Event was added, so nothing pauses
+    EXPECT_EQ(1u, reader.unresolvedEvents().size());
+
+    EXPECT_EQ("abd", readOpening(reader));
+    EXPECT_EQ(0u, reader.sceneCache().hits());
+}
+
+TEST_F(ReaderTests, ParsesTheScenesThatMayFollowAhead)
+{
+    std::ofstream{ sceneLoc / "Hub.json" } << R"([
+        { "lines": [ { "text": "h", "event": "setNextScene", "arg": "Hall" } ] },
+        { "lines": [ { "text": "", "event": "setNextScene", "arg": "Missing" } ],
+          "conditions": [ { "name": "expectEqual", "arguments": [ "setNextScene,1" ] } ] }
+    ])";
+    std::ofstream{ sceneLoc / "Hall.json" } << R"([ { "lines": [ { "text": "i" } ] } ])";
+
+    Reader reader{ sceneLoc.string(), sceneLoc.string() };
+    reader.setPacing(nullptr);
+    std::ostringstream ss;
+    reader.readFrom("Hub", ss);
+    EXPECT_EQ("hi", ss.str());
+    EXPECT_EQ(1u, reader.prefetchedScenes());
+
+    // Scenes already kept parsed aren't parsed ahead again.
+    reader.readFrom("Hub", ss);
+    EXPECT_EQ(1u, reader.prefetchedScenes());
+
+    Reader unprefetched{ sceneLoc.string(), sceneLoc.string() };
+    unprefetched.setPacing(nullptr);
+    unprefetched.setPrefetching(false);
+    unprefetched.readFrom("Hub", ss);
+    EXPECT_EQ(0u, unprefetched.prefetchedScenes());
+    EXPECT_EQ("hihihi", ss.str());
+}
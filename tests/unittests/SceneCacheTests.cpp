@@ -0,0 +1,85 @@
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Scenes/SceneCache.hpp"
+
+using namespace Scenes;
+using namespace std::chrono_literals;
+
+class SceneCacheTests : public testing::Test
+{
+protected:
+    size_t linesRead = 0;
+    Log sceneLog{ linesRead };
+    EventLog eventLog{ linesRead };
+    const std::filesystem::file_time_type modified = std::filesystem::file_time_type::clock::now();
+
+    SceneCache::Scene makeScene(size_t lines) const
+    {
+        return std::make_shared<const std::vector<Section> >(std::vector<Section>{
+            Section{ std::vector<Line>(lines, Line("A Line with text too long to be stored inline")), sceneLog,
+                     eventLog, {} }
+        });
+    }
+};
+
+TEST_F(SceneCacheTests, CountsHitsAndMisses)
+{
+    SceneCache cache;
+    EXPECT_EQ(nullptr, cache.find("Opening.json", modified));
+
+    const auto scene = makeScene(4);
+    cache.insert("Opening.json", modified, scene);
+    EXPECT_EQ(scene, cache.find("Opening.json", modified));
+    EXPECT_EQ(scene, cache.find("Opening.json", modified));
+
+    EXPECT_EQ(2u, cache.hits());
+    EXPECT_EQ(1u, cache.misses());
+    EXPECT_EQ(1u, cache.size());
+}
+
+TEST_F(SceneCacheTests, DropsScenesOfModifiedFiles)
+{
+    SceneCache cache;
+    cache.insert("Opening.json", modified, makeScene(4));
+
+    EXPECT_EQ(nullptr, cache.find("Opening.json", modified + 1s));
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.memoryUsage());
+    EXPECT_EQ(nullptr, cache.find("Opening.json", modified));
+}
+
+TEST_F(SceneCacheTests, DropsLeastRecentlyUsedScenesOverCapacity)
+{
+    const auto memory = [&](const SceneCache::Scene& scene)
+    {
+        SceneCache measured;
+        measured.insert("Scene.json", modified, scene);
+        return measured.memoryUsage();
+    };
+
+    const auto first = makeScene(100);
+    SceneCache cache{ 2 * memory(first) + memory(first) / 2 };
+    cache.insert("First.json", modified, first);
+    cache.insert("Second.json", modified, makeScene(100));
+    EXPECT_NE(nullptr, cache.find("First.json", modified)); // Second is now the least recently used
+
+    cache.insert("Third.json", modified, makeScene(100));
+    EXPECT_EQ(2u, cache.size());
+    EXPECT_LE(cache.memoryUsage(), cache.capacity());
+    EXPECT_NE(nullptr, cache.find("First.json", modified));
+    EXPECT_EQ(nullptr, cache.find("Second.json", modified));
+    EXPECT_NE(nullptr, cache.find("Third.json", modified));
+
+    // Scenes that can't fit at all aren't held.
+    cache.insert("Huge.json", modified, makeScene(100000));
+    EXPECT_EQ(nullptr, cache.find("Huge.json", modified));
+
+    cache.setCapacity(0);
+    EXPECT_EQ(0u, cache.size());
+    EXPECT_EQ(0u, cache.memoryUsage());
+}
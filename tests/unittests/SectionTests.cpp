@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
+#include <optional>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 #include "Scenes/Section.hpp"
 
@@ -69,11 +71,10 @@ TEST_F(SectionTests, TestSectionWithNoConditions)
 
 TEST_F(SectionTests, TestSectionWithInvalidCondition)
 {
-    Section section = createTestSection(
+    // Conditions are compiled when the Section is constructed, so invalid ones are rejected before any reading.
+    EXPECT_THROW(createTestSection(
         { Section::Condition("invalidCondition", { createEventString("Example Event", 2) }) }
-    );
-
-    EXPECT_THROW(sectionReadResult(section), std::out_of_range);
+    ), std::out_of_range);
 }
 
 TEST_F(SectionTests, TestSectionWithEqualityCondition)
@@ -90,16 +91,14 @@ TEST_F(SectionTests, TestSectionWithEqualityCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("expectEqual",
                              { createEventString("Example Event", 2),
                                createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithInequalityCondition)
@@ -116,16 +115,14 @@ TEST_F(SectionTests, TestSectionWithInequalityCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("expectNotEqual",
                              { createEventString("Example Event", 2),
                                createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithLowerThanCondition)
@@ -142,16 +139,14 @@ TEST_F(SectionTests, TestSectionWithLowerThanCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("expectLower",
                              { createEventString("Example Event", 5),
                                createEventString("Example Event", 5) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithLowerThanOrEqualCondition)
@@ -168,16 +163,14 @@ TEST_F(SectionTests, TestSectionWithLowerThanOrEqualCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("expectLowerOrEqual",
                              { createEventString("Example Event", 2),
                                createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithGreaterThanCondition)
@@ -194,16 +187,14 @@ TEST_F(SectionTests, TestSectionWithGreaterThanCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("expectHigher",
                              { createEventString("Example Event", 2),
                                createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithGreaterThanOrEqualCondition)
@@ -220,16 +211,14 @@ TEST_F(SectionTests, TestSectionWithGreaterThanOrEqualCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("expectHigherOrEqual",
                              { createEventString("Example Event", 2),
                                createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithTriggeredSinceSceneCondition)
@@ -246,14 +235,12 @@ TEST_F(SectionTests, TestSectionWithTriggeredSinceSceneCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("triggeredSinceLatestSceneCall", { createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithNotTriggeredSinceSceneCondition)
@@ -270,14 +257,12 @@ TEST_F(SectionTests, TestSectionWithNotTriggeredSinceSceneCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("notTriggeredSinceLatestSceneCall", { createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithTriggeredBeforeSceneCondition)
@@ -294,14 +279,12 @@ TEST_F(SectionTests, TestSectionWithTriggeredBeforeSceneCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("triggeredBeforeLatestSceneCall", { createEventString("Example Event", 2) }) }
-    };
-
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    }), std::invalid_argument);
 }
 
 TEST_F(SectionTests, TestSectionWithNotTriggeredBeforeSceneCondition)
@@ -318,14 +301,89 @@ TEST_F(SectionTests, TestSectionWithNotTriggeredBeforeSceneCondition)
 
     EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
 
-    Section invalid_size{
+    EXPECT_THROW((Section{
         std::queue<Line>(lineQueue),
         sceneLog,
         eventLog,
         { Section::Condition("notTriggeredBeforeLatestSceneCall", { createEventString("Example Event", 2) }) }
-    };
+    }), std::invalid_argument);
+}
+
+TEST_F(SectionTests, TestSectionWithTriggeredBetweenSceneCallsCondition)
+{
+    Section success = createTestSection(
+        { Section::Condition("triggeredBetweenLatestSceneCalls", { "Example Scene", createEventString("Example Event", 2) }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(success), lineQueue);
+
+    Section failure = createTestSection(
+        { Section::Condition("triggeredBetweenLatestSceneCalls", { "Example Scene", createEventString("Example Event", 5) }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(failure), std::deque<Line>());
+
+    Section singleSceneCall = createTestSection(
+        { Section::Condition("triggeredBetweenLatestSceneCalls", { "Example Scene 2", createEventString("Example Event", 5) }) }
+    );
 
-    EXPECT_THROW(sectionReadResult(invalid_size), std::invalid_argument);
+    EXPECT_EQ(sectionReadResult(singleSceneCall), std::deque<Line>());
+}
+
+TEST_F(SectionTests, TestSectionWithTriggeredCountSinceSceneConditions)
+{
+    Section atLeast = createTestSection(
+        { Section::Condition("triggeredAtLeastSinceLatestSceneCall",
+                             { "Example Scene", createEventString("Example Event", 5), "1" }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(atLeast), lineQueue);
+
+    Section notAtLeast = createTestSection(
+        { Section::Condition("triggeredAtLeastSinceLatestSceneCall",
+                             { "Example Scene", createEventString("Example Event", 2), "1" }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(notAtLeast), std::deque<Line>());
+
+    Section fewerThan = createTestSection(
+        { Section::Condition("triggeredFewerThanSinceLatestSceneCall",
+                             { "Example Scene", createEventString("Example Event", 5), "2" }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(fewerThan), lineQueue);
+
+    Section notFewerThan = createTestSection(
+        { Section::Condition("triggeredFewerThanSinceLatestSceneCall",
+                             { "Example Scene", createEventString("Example Event", 5), "1" }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(notFewerThan), std::deque<Line>());
+
+    EXPECT_THROW(createTestSection(
+        { Section::Condition("triggeredAtLeastSinceLatestSceneCall",
+                             { "Example Scene", createEventString("Example Event", 5) }) }
+    ), std::invalid_argument);
+}
+
+TEST_F(SectionTests, TestSectionWithDiscardedRecords)
+{
+    sceneLog.setRetention(RetentionPolicy::summary());
+    eventLog.setRetention(RetentionPolicy::summary());
+    sceneLog.compact();
+    eventLog.compact();
+
+    Section latestOnly = createTestSection(
+        { Section::Condition("triggeredSinceLatestSceneCall", { "Example Scene", createEventString("Example Event", 5) }) }
+    );
+
+    EXPECT_EQ(sectionReadResult(latestOnly), lineQueue);
+
+    Section needsHistory = createTestSection(
+        { Section::Condition("triggeredBetweenLatestSceneCalls", { "Example Scene", createEventString("Example Event", 2) }) }
+    );
+
+    EXPECT_THROW(sectionReadResult(needsHistory), DiscardedLogError);
 }
 
 TEST_F(SectionTests, TestSectionWithMultipleConditions)
@@ -340,7 +398,231 @@ TEST_F(SectionTests, TestSectionWithMultipleConditions)
     EXPECT_EQ(sectionReadResult(section), lineQueue);
 }
 
+TEST_F(SectionTests, EventNamesOfConditions)
+{
+    Section section = createTestSection(
+        {
+            Section::Condition("notTriggeredBeforeLatestSceneCall", { "Example Scene", createEventString("Door", 1) }),
+            Section::Condition("expectHigherOrEqual", { createEventString("Example Event", 5) }),
+            Section::Condition("expectEqual", { createEventString("Door", 2) })
+        }
+    );
+
+    EXPECT_EQ((std::vector<std::string>{ "Example Event", "Door" }), section.eventNames()); // Cheapest first
+    EXPECT_TRUE(createTestSection({}).eventNames().empty());
+}
+
+TEST_F(SectionTests, LinkReportsUnresolvedLines)
+{
+    events.emplace("Example Event", [](const std::string&) -> int { return 3; }, eventLog);
+
+    Section section{
+        std::queue<Line>({ Line("Line 1", "Example Event", ""), Line("Line 2", "Misspelled Event", ""),
+                           Line("Line 3"), Line("Line 4", "Other Misspelled Event", "") }),
+        sceneLog, eventLog, {}
+    };
+
+    std::vector<std::string> unresolved;
+    section.link(events, [&](const Line& line) { unresolved.push_back(line.eventName().value()); });
+    EXPECT_EQ((std::vector<std::string>{ "Misspelled Event", "Other Misspelled Event" }), unresolved);
+
+    // Linked Lines keep their order and run their Events by index.
+    std::stringstream ss;
+    while (section.isActive())
+        section.readLine(ss, events);
+    EXPECT_EQ("Line 1Line 2Line 3Line 4", ss.str());
+    EXPECT_EQ(1, eventLog.count("Example Event,3"));
+}
+
+TEST_F(SectionTests, LinkKeepsOrderWhenArgumentIsMalformed)
+{
+    events.emplace("Typed Event", [](const EventArgument& arg) { return arg.get<int>(); }, eventLog,
+                   [](const std::string& text) { return EventArgument(parseArgument<int>(text)); });
+
+    Section section{
+        std::queue<Line>({ Line("Line 1", "Typed Event", "1"), Line("Line 2", "Typed Event", "two"), Line("Line 3") }),
+        sceneLog, eventLog, {}
+    };
+    EXPECT_THROW(section.link(events, [](const Line&) {}), EventArgumentError);
+
+    std::stringstream ss;
+    while (section.isActive())
+        section.readLine(ss, events);
+    EXPECT_EQ("Line 1Line 2Line 3", ss.str());
+}
+
+TEST_F(SectionTests, FindPredicate)
+{
+    EXPECT_EQ(std::make_pair(Section::Predicate::ExpectEqual, size_t{ 1 }), Section::findPredicate("expectEqual"));
+    EXPECT_EQ(std::make_pair(Section::Predicate::TriggeredFewerThanSinceLatestSceneCall, size_t{ 3 }),
+              Section::findPredicate("triggeredFewerThanSinceLatestSceneCall"));
+    EXPECT_FALSE(Section::findPredicate("invalidCondition"));
+}
+
+TEST_F(SectionTests, MovedSectionChecksItsOwnConditions)
+{
+    std::optional<Section> original = createTestSection(
+        { Section::Condition("expectHigherOrEqual", { createEventString("Example Event", 5) }) }
+    );
+    Section moved = std::move(*original);
+    original.reset();
+
+    EXPECT_EQ(sectionReadResult(std::move(moved)), lineQueue);
+}
+
+TEST_F(SectionTests, CompileParsesConditionArguments)
+{
+    const auto instruction = Section::compile(
+        Section::Condition("triggeredFewerThanSinceLatestSceneCall",
+                           { "Example Scene", createEventString("Example Event", 5), "3" }), eventLog
+    );
+    EXPECT_EQ(Section::Predicate::TriggeredFewerThanSinceLatestSceneCall, instruction.opcode);
+    EXPECT_EQ((EventKey{ eventLog.intern("Example Event"), 5 }), instruction.event);
+    EXPECT_EQ(3, instruction.count);
+    EXPECT_EQ("Example Scene", instruction.scene);
+
+    EXPECT_THROW((void)Section::compile(Section::Condition("expectEqual", { "Example Event, 5" }), eventLog),
+                 std::invalid_argument);
+    EXPECT_THROW((void)Section::compile(Section::Condition("triggeredAtLeastSinceLatestSceneCall",
+                                                           { "Example Scene", "Example Event,5", "many" }), eventLog),
+                 std::invalid_argument);
+}
+
+TEST_F(SectionTests, TestSectionWithConditionExpressions)
+{
+    const auto expectEqual = [](int returnValue) {
+        return Section::Condition("expectEqual", { createEventString("Example Event", returnValue) });
+    };
+
+    Section anyOf = createTestSection({ Section::Condition::anyOf({ expectEqual(8), expectEqual(5) }) });
+    EXPECT_EQ(sectionReadResult(anyOf), lineQueue);
+
+    Section noneOf = createTestSection({ Section::Condition::anyOf({ expectEqual(8), expectEqual(9) }) });
+    EXPECT_EQ(sectionReadResult(noneOf), std::deque<Line>());
+
+    Section nested = createTestSection(
+        {
+            Section::Condition::negation(Section::Condition::allOf({ expectEqual(2), expectEqual(8) })),
+            expectEqual(5)
+        }
+    );
+    EXPECT_EQ(sectionReadResult(nested), lineQueue);
+
+    // An empty "or" is false, so its negation is true.
+    EXPECT_TRUE(createTestSection({ Section::Condition::negation(Section::Condition::anyOf({})) }).isActive());
+}
+
+TEST_F(SectionTests, CompileProgramChecksCheapestFirst)
+{
+    const auto program = Section::compileProgram(
+        {
+            Section::Condition::allOf({
+                Section::Condition("triggeredAtLeastSinceLatestSceneCall",
+                                   { "Example Scene", createEventString("Example Event", 5), "1" }),
+                Section::Condition("triggeredFewerThanSinceLatestSceneCall",
+                                   { "Example Scene", createEventString("Example Event", 5), "3" })
+            }),
+            Section::Condition::anyOf({
+                Section::Condition("triggeredSinceLatestSceneCall", { "Example Scene", "Door,1" }),
+                Section::Condition("expectEqual", { "Door,1" })
+            })
+        }, eventLog
+    );
+
+    ASSERT_EQ(7, program.size());
+    EXPECT_EQ(Section::Predicate::And, program[0].opcode);
+    EXPECT_EQ(7, program[0].length);
+    EXPECT_EQ(Section::Predicate::Or, program[1].opcode);
+    EXPECT_EQ(3, program[1].length);
+    EXPECT_EQ(Section::Predicate::ExpectEqual, program[2].opcode);
+    EXPECT_EQ(Section::Predicate::TriggeredSinceLatestSceneCall, program[3].opcode);
+    EXPECT_EQ(Section::Predicate::And, program[4].opcode);
+    EXPECT_EQ(3, program[4].length);
+    EXPECT_EQ(Section::Predicate::TriggeredAtLeastSinceLatestSceneCall, program[5].opcode);
+
+    Section::Condition notWithTwoOperands = Section::Condition::negation(Section::Condition("expectEqual", { "A,1" }));
+    notWithTwoOperands.operands.push_back(notWithTwoOperands.operands.front());
+    EXPECT_THROW((void)Section::compileProgram({ notWithTwoOperands }, eventLog), std::invalid_argument);
+}
+
 TEST_F(SectionTests, IsMoveConstructible)
 {
     EXPECT_TRUE(std::is_move_constructible<Section>::value);
-}
\ No newline at end of file
+}
+TEST_F(SectionTests, ChecksConditionsAgainOnceTheirRecordsChange)
+{
+    Section section = createTestSection({
+        Section::Condition("expectNotEqual", { createEventString("Door", 1) }),
+        Section::Condition("notTriggeredSinceLatestSceneCall", { "Cellar", createEventString("Example Event", 5) })
+    });
+    std::stringstream ss;
+    ASSERT_TRUE(section.isActive());
+    section.readLine(ss, events);
+
+    // Records the Conditions don't query leave the checked state alone.
+    eventLog.addLog(createEventString("Window", 1));
+    sceneLog.addLog("Example Scene");
+    EXPECT_TRUE(section.isActive());
+
+    eventLog.addLog(createEventString("Door", 1));
+    EXPECT_FALSE(section.isActive());
+
+    // Copies are checked again on their own.
+    const Section copy = section;
+    EXPECT_FALSE(copy.isActive());
+
+    Section cellar = createTestSection({
+        Section::Condition("notTriggeredSinceLatestSceneCall", { "Cellar", createEventString("Example Event", 5) })
+    });
+    EXPECT_TRUE(cellar.isActive());
+    sceneLog.addLog("Cellar");
+    eventLog.addLog(createEventString("Example Event", 5));
+    EXPECT_FALSE(cellar.isActive());
+}
+
+TEST_F(SectionTests, CopiesShareLinesAndKeepTheirOwnCursor)
+{
+    events.emplace("Example Event", [](const std::string&) -> int { return 3; }, eventLog);
+
+    Section section{
+        std::vector<Line>{ Line("Line 1", "Example Event", ""), Line("Line 2"), Line("Line 3") }, sceneLog, eventLog, {}
+    };
+    std::stringstream ss;
+    section.readLine(ss, events);
+
+    Section copy = section;
+    EXPECT_EQ(section.lines(), copy.lines());
+    copy.readLine(ss, events);
+    copy.readLine(ss, events);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_FALSE(section.empty());
+    EXPECT_EQ("Line 1Line 2Line 3", ss.str());
+
+    // Rewinding reads every Line again, including the ones read before the copy was made.
+    copy.rewind();
+    EXPECT_EQ(sectionReadResult(copy), (std::deque<Line>{ Line("Line 1"), Line("Line 2"), Line("Line 3") }));
+
+    // Linking takes a copy of shared Lines rather than changing the Lines other Sections read.
+    copy.link(events, [](const Line&) {});
+    EXPECT_NE(section.lines(), copy.lines());
+    EXPECT_TRUE(copy.lines()->front().linked());
+    EXPECT_FALSE(section.lines()->front().linked());
+
+    // Lines that are already linked are only reported, so the shared Lines are kept.
+    const Section linked = copy;
+    Section relinked = linked;
+    relinked.link(events, [](const Line&) {});
+    EXPECT_EQ(linked.lines(), relinked.lines());
+}
+
+TEST_F(SectionTests, MemoryUsageCountsOnlyUnsharedLines)
+{
+    const Line line{ "A Line with text too long to be stored inline" };
+    Section section{ std::vector<Line>(100, line), sceneLog, eventLog, {} };
+    const auto unshared = section.memoryUsage();
+    EXPECT_GT(unshared, 100 * sizeof(Line));
+
+    const Section copy = section;
+    EXPECT_LT(section.memoryUsage(), unshared - 100 * sizeof(Line));
+    EXPECT_EQ(section.memoryUsage(), copy.memoryUsage());
+}
@@ -0,0 +1,49 @@
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include "Scenes/Serializations.hpp"
+
+using namespace Scenes;
+
+TEST(SerializationsTests, ReadsLineEvents)
+{
+    const auto line = nlohmann::json::parse(R"({
+        "text": "The door creaks open.",
+        "event": "openDoor", "arg": "north",
+        "events": [ { "event": "playSound", "arg": "creak" }, { "event": "shake" } ]
+    })").get<Line>();
+
+    EXPECT_EQ("The door creaks open.", line.text());
+    EXPECT_EQ((EventCalls{ { "openDoor", "north" }, { "playSound", "creak" }, { "shake" } }), line.events());
+    EXPECT_TRUE(nlohmann::json::parse(R"({ "text": "Silence.", "event": null })").get<Line>().events().empty());
+
+    EXPECT_EQ(line, nlohmann::json(line).get<Line>());
+    const Line single{ "Knock.", "knock", "" };
+    EXPECT_EQ(single, nlohmann::json(single).get<Line>());
+}
+
+TEST(SerializationsTests, ReadsConditionExpressions)
+{
+    const auto conditions = nlohmann::json::parse(R"([
+        { "name": "expectEqual", "arguments": [ "Door,1" ] },
+        { "or": [
+            { "name": "expectEqual", "arguments": [ "Key,1" ] },
+            { "not": { "name": "expectHigher", "arguments": [ "Lock,2" ] } }
+        ] }
+    ])").get<Section::ConditionVector>();
+
+    ASSERT_EQ(2, conditions.size());
+    EXPECT_EQ("expectEqual", conditions[0].name);
+    EXPECT_EQ(std::vector<std::string>{ "Door,1" }, conditions[0].arguments);
+
+    const auto& anyOf = conditions[1];
+    EXPECT_EQ("or", anyOf.name);
+    ASSERT_EQ(2, anyOf.operands.size());
+    EXPECT_EQ("not", anyOf.operands[1].name);
+    ASSERT_EQ(1, anyOf.operands[1].operands.size());
+    EXPECT_EQ("expectHigher", anyOf.operands[1].operands[0].name);
+
+    EXPECT_EQ(nlohmann::json(conditions), nlohmann::json(nlohmann::json(conditions).get<Section::ConditionVector>()));
+}
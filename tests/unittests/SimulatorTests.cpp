@@ -0,0 +1,121 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "Scenes/Simulator.hpp"
+
+using namespace Scenes;
+
+class SimulatorTests : public testing::Test
+{
+protected:
+    std::filesystem::path sceneLoc;
+
+    SimulatorTests()
+        : sceneLoc(std::filesystem::temp_directory_path()
+                   / ("SimulatorTests." + std::string(testing::UnitTest::GetInstance()->current_test_info()->name())
+                      + "." + std::to_string(std::random_device{}())))
+    {
+        std::filesystem::remove_all(sceneLoc);
+        std::filesystem::create_directories(sceneLoc);
+
+        writeScene("Opening", R"([
+            { "lines": [ { "text": "You wake up.", "event": "findSecret" } ] },
+            { "lines": [ { "text": "A hidden door.", "event": "setNextScene", "arg": "Secret" } ],
+              "conditions": [ { "name": "expectEqual", "arguments": [ "findSecret,1" ] } ] },
+            { "lines": [ { "text": "Nothing here.", "event": "setNextScene", "arg": "Hall" } ],
+              "conditions": [ { "name": "expectEqual", "arguments": [ "findSecret,0" ] } ] },
+            { "lines": [ { "text": "Never read." } ],
+              "conditions": [ { "name": "expectEqual", "arguments": [ "findSecret,2" ] } ] }
+        ])");
+        writeScene("Secret", R"([ { "lines": [ { "text": "Treasure!", "event": "loot", "arg": "gold" } ] } ])");
+        writeScene("Hall", R"([ { "lines": [ { "text": "A long hall." } ] } ])");
+        writeScene("Loop", R"([ { "lines": [ { "text": "Again.", "event": "setNextScene", "arg": "Loop" } ] } ])");
+    }
+
+    ~SimulatorTests() override
+    {
+        std::filesystem::remove_all(sceneLoc);
+    }
+
+    void writeScene(const std::string& name, const std::string& json) const
+    {
+        std::ofstream{ sceneLoc / (name + ".json") } << json;
+    }
+};
+
+TEST_F(SimulatorTests, CollectsEventNames)
+{
+    const Simulator simulator{ sceneLoc, "Opening", std::make_shared<ScriptedResponder>(
+        std::unordered_map<std::string, int>{}) };
+    EXPECT_EQ((std::vector<std::string>{ "findSecret", "loot", "setNextScene" }), simulator.eventNames());
+}
+
+TEST_F(SimulatorTests, ReportsCoverageOfRandomPlaythroughs)
+{
+    const Simulator simulator{ sceneLoc, "Opening", std::make_shared<RandomResponder>(
+        std::unordered_map<std::string, std::vector<int> >{ { "findSecret", { 0, 1 } } }) };
+    SimulationOptions options;
+    options.sessions = 200;
+    options.workers = 4;
+    options.seed = 7;
+    const auto report = simulator.run(options);
+
+    EXPECT_EQ(200u, report.sessions);
+    EXPECT_EQ(200u, report.finished);
+    EXPECT_EQ(0u, report.stopped);
+    EXPECT_EQ(0u, report.failed);
+
+    EXPECT_EQ(200u, report.scenes.at("Opening"));
+    EXPECT_EQ(200u, report.scenes.at("Secret") + report.scenes.at("Hall"));
+    EXPECT_GT(report.scenes.at("Secret"), 0u);
+    EXPECT_GT(report.scenes.at("Hall"), 0u);
+
+    const auto& findSecret = report.eventReturns.at("findSecret");
+    EXPECT_EQ(report.scenes.at("Hall"), findSecret.at(0));
+    EXPECT_EQ(report.scenes.at("Secret"), findSecret.at(1));
+    EXPECT_EQ(report.scenes.at("Secret"), report.eventReturns.at("loot").at(0));
+    EXPECT_EQ(report.scenes.at("Secret"), report.endings.at("Secret"));
+
+    EXPECT_EQ((std::vector<std::string>{ "Loop" }), report.unvisitedScenes);
+    EXPECT_EQ((std::vector<std::pair<std::string, size_t> >{ { "Loop", 0 }, { "Opening", 3 } }), report.unreadSections);
+
+    // Sessions are seeded by their index, so the same seed gives the same coverage on any number of workers.
+    options.workers = 1;
+    EXPECT_EQ(report.sections, simulator.run(options).sections);
+}
+
+TEST_F(SimulatorTests, StopsSessionsAtTheLineLimit)
+{
+    const Simulator simulator{ sceneLoc, "Loop", std::make_shared<ScriptedResponder>(
+        std::unordered_map<std::string, int>{}) };
+    SimulationOptions options;
+    options.sessions = 8;
+    options.workers = 2;
+    options.lineLimit = 50;
+    const auto report = simulator.run(options);
+
+    EXPECT_EQ(8u, report.stopped);
+    EXPECT_EQ(0u, report.finished);
+    EXPECT_TRUE(report.endings.empty());
+    EXPECT_EQ(8u, report.sections.at({ "Loop", 0 }));
+}
+
+TEST_F(SimulatorTests, KeepsEventsAddedBySetup)
+{
+    const Simulator simulator{ sceneLoc, "Opening", std::make_shared<ScriptedResponder>(
+        std::unordered_map<std::string, int>{ { "findSecret", 0 } }) };
+    SimulationOptions options;
+    options.sessions = 4;
+    options.setup = [](Reader& reader) { reader.addEvent("findSecret", [] { return 1; }); };
+    const auto report = simulator.run(options);
+
+    EXPECT_EQ(4u, report.scenes.at("Secret"));
+    EXPECT_FALSE(report.scenes.contains("Hall"));
+    EXPECT_FALSE(report.eventReturns.contains("findSecret"));
+}
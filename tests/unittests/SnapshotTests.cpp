@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <filesystem>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <gtest/gtest.h>
+
+#include "Scenes/EventLog.hpp"
+#include "Scenes/Section.hpp"
+#include "Scenes/Snapshot.hpp"
+
+using namespace Scenes;
+
+class SnapshotTests : public testing::Test
+{
+protected:
+	size_t linesRead;
+	Log log;
+	EventLog eventLog;
+
+	SnapshotTests()
+		: linesRead(0), log(linesRead), eventLog(linesRead)
+	{
+		for (linesRead = 1; linesRead <= 1000; linesRead++)
+		{
+			log.addLog("Scene " + std::to_string(linesRead % 3));
+			eventLog.addLog("Example Event," + std::to_string(linesRead % 5));
+		}
+		eventLog.addLog("Not an eventString");
+		eventLog.setRetention(eventLog.intern("Example Event"), RetentionPolicy::keepLast(10));
+	}
+
+	std::vector<char> write(const Log& source) const
+	{
+		SnapshotWriter writer;
+		writer.writeHeader();
+		source.writeSnapshot(writer);
+		return writer.data();
+	}
+};
+
+TEST_F(SnapshotTests, LogRoundTrip)
+{
+	const auto data = write(log);
+
+	Log restored(linesRead);
+	SnapshotReader reader{ data };
+	reader.readHeader();
+	restored.readSnapshot(reader);
+
+	EXPECT_TRUE(reader.atEnd());
+	for (const auto name : { "Scene 0", "Scene 1", "Scene 2" })
+		EXPECT_EQ(log.query(name), restored.query(name));
+	EXPECT_EQ(log.countBetween("Scene 1", 100, 200), restored.countBetween("Scene 1", 100, 200));
+}
+
+TEST_F(SnapshotTests, EventLogRoundTripKeepsExistingIds)
+{
+	const auto data = write(eventLog);
+
+	EventLog restored(linesRead);
+	const auto other = restored.intern("Other Event");
+	SnapshotReader reader{ data };
+	reader.readHeader();
+	restored.readSnapshot(reader);
+
+	const auto id = restored.findId("Example Event");
+	ASSERT_TRUE(id.has_value());
+	EXPECT_NE(other, *id);
+	EXPECT_EQ(other, restored.intern("Other Event"));
+
+	for (int returnValue = 0; returnValue < 5; returnValue++)
+	{
+		const auto eventString = "Example Event," + std::to_string(returnValue);
+		EXPECT_EQ(eventLog.query(eventString), restored.query(EventKey{ *id, returnValue }));
+		EXPECT_EQ(eventLog.count(eventString), restored.count(eventString));
+	}
+	EXPECT_EQ(eventLog.query("Not an eventString"), restored.query("Not an eventString"));
+	EXPECT_EQ(eventLog.highestReturn("Example Event"), restored.highestReturn("Example Event"));
+
+	// Retention set per Event name carries over to records added after the restore.
+	for (linesRead = 2000; linesRead < 2100; linesRead++)
+		restored.addLog(EventKey{ *id, 7 });
+	EXPECT_THROW((void) restored.countBetween(EventKey{ *id, 7 }, 2000, 2050), DiscardedLogError);
+}
+
+TEST_F(SnapshotTests, EventLogAdoptsEventStringsKeptByName)
+{
+	// A snapshot whose eventStrings were all kept by name, as before Events were interned.
+	Log named(linesRead);
+	for (linesRead = 1; linesRead <= 10; linesRead++)
+		named.addLog("Door," + std::to_string(linesRead % 2 ? 3 : -1));
+	named.addLog("Window");
+
+	// It also holds an interned record of "Door,3", whose lines are merged with the named one.
+	LogRecord interned{ RetentionPolicy::keepAll() };
+	interned.append(11);
+
+	SnapshotWriter writer;
+	writer.writeHeader();
+	named.writeSnapshot(writer);
+	writer.write<std::uint64_t>(1);
+	writer.writeString("Door");
+	writer.write<std::uint64_t>(0);
+	writer.write<std::uint64_t>(1);
+	writer.write<EventId>(0);
+	writer.write(3);
+	interned.write(writer);
+	const auto data = writer.data();
+
+	EventLog restored(linesRead);
+	SnapshotReader reader{ data };
+	reader.readHeader();
+	restored.readSnapshot(reader);
+
+	EXPECT_EQ(-1, restored.lowestReturn("Door"));
+	EXPECT_EQ(3, restored.highestReturn("Door"));
+	EXPECT_TRUE(restored.anyReturnBetween("Door", -5, -1));
+	EXPECT_EQ(named.query("Door,-1"), restored.query("Door,-1"));
+	EXPECT_EQ((LogResultType{ 1, 3, 5, 7, 9, 11 }), restored.query(EventKey{ *restored.findId("Door"), 3 }));
+	EXPECT_EQ(named.query("Window"), restored.query("Window"));
+}
+
+TEST_F(SnapshotTests, EventLogMergesCompactedRecordsKeptByName)
+{
+	// Both the named and the interned record of "Door,3" have discarded line numbers.
+	Log named(linesRead);
+	named.setRetention("Door,3", RetentionPolicy::keepLast(3));
+	for (linesRead = 1; linesRead <= 20; linesRead++)
+		named.addLog("Door,3");
+
+	LogRecord interned{ RetentionPolicy::keepLast(3) };
+	for (size_t line = 30; line <= 40; line++)
+		interned.append(line);
+
+	SnapshotWriter writer;
+	writer.writeHeader();
+	named.writeSnapshot(writer);
+	writer.write<std::uint64_t>(1);
+	writer.writeString("Door");
+	writer.write<std::uint64_t>(0);
+	writer.write<std::uint64_t>(1);
+	writer.write<EventId>(0);
+	writer.write(3);
+	interned.write(writer);
+	const auto data = writer.data();
+
+	EventLog restored(linesRead);
+	SnapshotReader reader{ data };
+	reader.readHeader();
+	restored.readSnapshot(reader);
+
+	const EventKey door{ *restored.findId("Door"), 3 };
+	EXPECT_EQ(31u, restored.count(door));
+	EXPECT_EQ(1u, restored.first("Door,3"));
+	EXPECT_EQ(40u, restored.last("Door,3"));
+	EXPECT_EQ(31u, restored.countBetween(door, 1, 40));
+	EXPECT_EQ((LogResultType{ 38, 39, 40 }), restored.query(door));
+	EXPECT_THROW((void) restored.countBetween(door, 20, 40), DiscardedLogError);
+}
+
+TEST_F(SnapshotTests, SectionRoundTrip)
+{
+	std::queue<Line> lines;
+	lines.emplace("First line");
+	lines.emplace("Second line", "Example Event", "argument");
+	const Section section(lines, log, eventLog, { { "expectEqual", { "Example Event,4" } } });
+	ASSERT_TRUE(section.isActive());
+
+	SnapshotWriter writer;
+	section.writeSnapshot(writer);
+
+	SnapshotReader reader{ writer.data() };
+	Section restored(reader, log, eventLog);
+	EXPECT_TRUE(reader.atEnd());
+	EXPECT_TRUE(restored.isActive());
+
+	EventMap events;
+	std::stringstream stream;
+	restored.readLine(stream, events);
+	restored.readLine(stream, events);
+	EXPECT_EQ("First lineSecond line", stream.str());
+	EXPECT_TRUE(restored.empty());
+}
+
+TEST_F(SnapshotTests, MappedFileRoundTrip)
+{
+	const auto path = std::filesystem::temp_directory_path()
+		/ ("SnapshotTests.MappedFileRoundTrip." + std::to_string(std::random_device{}()) + ".bin");
+
+	SnapshotWriter writer;
+	writer.writeHeader();
+	eventLog.writeSnapshot(writer);
+	writer.saveTo(path);
+	EXPECT_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+	{
+		const MappedFile file{ path };
+		EXPECT_TRUE(std::ranges::equal(writer.data(), file.data()));
+
+		EventLog restored(linesRead);
+		SnapshotReader reader{ file.data() };
+		reader.readHeader();
+		restored.readSnapshot(reader);
+		EXPECT_EQ(eventLog.query("Example Event,3"), restored.query("Example Event,3"));
+	}
+
+	std::filesystem::remove(path);
+	EXPECT_THROW(MappedFile{ path }, SnapshotError);
+}
+
+TEST_F(SnapshotTests, RejectsBadSnapshots)
+{
+	auto data = write(eventLog);
+
+	auto badMagic = data;
+	badMagic[0] ^= 1;
+	SnapshotReader badMagicReader{ badMagic };
+	EXPECT_THROW(badMagicReader.readHeader(), SnapshotError);
+
+	auto badVersion = data;
+	badVersion[4] ^= 1;
+	SnapshotReader badVersionReader{ badVersion };
+	EXPECT_THROW(badVersionReader.readHeader(), SnapshotError);
+
+	// Every truncation of a snapshot must throw rather than read past the end.
+	for (size_t size = 10; size < data.size(); size += 37)
+	{
+		EventLog restored(linesRead);
+		SnapshotReader reader{ std::span<const char>(data.data(), size) };
+		reader.readHeader();
+		EXPECT_THROW(restored.readSnapshot(reader), SnapshotError);
+	}
+}